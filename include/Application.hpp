@@ -22,6 +22,11 @@ private:
 
     void beginSearch();
     void reset();
+    void toggleDiagonalMovement();
+    void cycleCornerCutting();
+    void cycleAlgorithm();
+    void togglePruning();
+    void toggleNativeMaze();
 
 private:
     int m_Width;
@@ -2,26 +2,26 @@
 #define GRID_HPP
 
 #include "Node.hpp"
-
+#include "core/ConnectedComponents.hpp"
+#include "core/GridMap.hpp"
+#include "core/LandmarkTable.hpp"
+#include "core/MapFile.hpp"
+#include "core/MazeLoader.hpp"
+#include "core/MazeMap.hpp"
+#include "core/MazeSearch.hpp"
+#include "core/Path.hpp"
+#include "core/PathfinderFactory.hpp"
+
+#include <memory>
 #include <vector>
 #include <SFML/Graphics.hpp>
 
-enum class Direction
-{
-    North,
-    NorthEast,
-    East,
-    SouthEast,
-    South,
-    SouthWest,
-    West,
-    NorthWest
-};
-
+// Renders a GridMap and forwards edits and searches to the core library
 class Grid : public sf::Drawable
 {
 public:
     Grid(int numNodes, const sf::Vector2i& gridSize);
+    // Throws std::runtime_error if the file cannot be loaded
     Grid(const std::string& file, const sf::Vector2i& gridSize);
 
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
@@ -33,7 +33,18 @@ public:
 
     sf::Vector2i getGridSize() const;
     sf::Vector2i getNodeSize() const;
-    int getNumNodes() const;
+    sf::Vector2i getNumNodes() const;
+
+    void setConnectivity(Connectivity connectivity);
+    Connectivity getConnectivity() const;
+    void setCornerCutting(CornerCutting cornerCutting);
+    CornerCutting getCornerCutting() const;
+    void setAlgorithm(SearchAlgorithm algorithm);
+    SearchAlgorithm getAlgorithm() const;
+    void setPruning(bool isPruning);
+    bool isPruning() const;
+    void setNativeMaze(bool isNativeMaze);
+    bool isNativeMaze() const;
 
     void reset();
 
@@ -42,49 +53,54 @@ public:
 private:
     void createNodes();
     void createLines();
-
-    void parseNodes(const std::string& file);
-    std::vector<std::vector<std::string>> extractNodes(const std::string& file);
-    int parseNumNodes(const std::string& file) const;
+    void createSearch();
+    bool isUsingLandmarks() const;
+    void colorWalls(const sf::Color& color = sf::Color::Black);
+    bool canSearchMaze() const;
 
     void drawNodes(sf::RenderTarget& target, sf::RenderStates states) const;
     void drawLines(sf::RenderTarget& target, sf::RenderStates states) const;
 
-    int calculateHeuristicCost(const sf::Vector2i& from, const sf::Vector2i& to) const;
-    int calculateMovementCost(const sf::Vector2i& from, const sf::Vector2i& to) const;
-
-    sf::Vector2i getLowestScoredNode(const std::vector<sf::Vector2i>& nodes) const;
-    std::vector<sf::Vector2i> getNeighborNodes(const sf::Vector2i& node) const;
-    sf::Vector2i getAdjacentNode(const sf::Vector2i& from, Direction direction) const;
-    std::vector<sf::Vector2i> getAdjacentNodes(const sf::Vector2i& from, const std::vector<Direction>& directions) const;
-
-    bool isNodeOnEdge(const sf::Vector2i& node) const;
-    bool isNodeOnLeft(const sf::Vector2i& node) const;
-    bool isNodeOnRight(const sf::Vector2i& node) const;
-    bool isNodeOnTop(const sf::Vector2i& node) const;
-    bool isNodeOnBottom(const sf::Vector2i& node) const;
-
-    void buildPath(const sf::Vector2i& position);
     void printPath();
     void colorPath(const sf::Color& color = sf::Color::Yellow);
 
+    int getNodeIndex(const sf::Vector2i& position) const;
+    static Point toPoint(const sf::Vector2i& position);
+
 private:
-    int m_NumNodes;
     const sf::Vector2i GRID_SIZE;
-    const int HORIZONTAL_COST;
-    const int VERTICAL_COST;
-    const int DIAGONAL_COST;
 
-    std::vector<std::vector<Node>> m_Nodes;
+    // Outlives the map, which may view its walls
+    MapFile m_MapFile;
+
+    GridMap m_Map;
+    ConnectedComponents m_Components;
+
+    // A heuristic that sees walls, for A* on mazes. Only made once that is
+    // the selected search, as building it runs a Dijkstra per landmark.
+    std::unique_ptr<LandmarkTable> m_Landmarks;
+
+    // The maze as loaded. It is searched directly, a quarter of the
+    // cells, for as long as the grid is as it was expanded and the search
+    // is between maze cells.
+    MazeMap m_Maze;
+    std::unique_ptr<MazeSearch> m_MazeSearch;
+    unsigned m_MazeRevision;
+    bool m_IsNativeMaze;
+
+    SearchAlgorithm m_Algorithm;
+    bool m_IsPruning;
+    std::unique_ptr<Pathfinder> m_Search;
+
+    std::vector<Node> m_Nodes;
     std::vector<sf::RectangleShape> m_Lines;
 
     sf::Vector2i m_StartPosition;
     sf::Vector2i m_EndPosition;
 
-    std::vector<sf::Vector2i> m_Walls;
-
     bool m_HasFoundPath;
-    std::vector<sf::Vector2i> m_Path;
+    std::vector<Point> m_Path;
+    PathWriter m_PathWriter;
 
     bool m_IsMaze;
 };
@@ -11,15 +11,7 @@ public:
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
     sf::Vector2i getPosition() const;
-    sf::Vector2i getParentPosition() const;
-    int getScore() const;
-    int getMovementCost() const;
-    int getHeuristicCost() const;
-
-    void setParentPosition(const sf::Vector2i& parentPosition);
-    void setScore(int score);
-    void setMovementCost(int movementCost);
-    void setHeuristicCost(int heuristicCost);
+
     void setColor(const sf::Color& color);
 
 private:
@@ -27,12 +19,6 @@ private:
 
 private:
     sf::Vector2i m_Position;
-    sf::Vector2i m_ParentPosition;
-
-    int m_Score;
-    int m_MovementCost;
-    int m_HeuristicCost;
-
     sf::Vector2i m_Size;
     sf::RectangleShape m_Shape;
 };
@@ -0,0 +1,154 @@
+#ifndef ASTARSEARCH_HPP
+#define ASTARSEARCH_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Heuristics.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/SearchSpace.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// A* over a GridMap. The heuristic and cost policy are template
+// parameters so both inline into the search loop.
+//
+// With a suboptimality bound epsilon > 0 it runs weighted A*, scoring
+// nodes with g + (1 + epsilon) * h. Given a consistent heuristic the
+// path found costs at most (1 + epsilon) times the optimal cost.
+//
+// The open set is a template parameter too: BinaryHeap<SearchKey>, or a
+// BucketQueue, which suits the small integer scores of GridCost.
+template <typename Heuristic, typename Cost = GridCost, typename OpenList = BinaryHeap<SearchKey>>
+class AStarSearch : public Pathfinder
+{
+    static_assert(std::is_same<typename Heuristic::Cost, Cost>::value,
+                  "The heuristic must estimate the same cost policy the search uses");
+
+public:
+    explicit AStarSearch(const GridMap& map, const Heuristic& heuristic = Heuristic())
+        : m_Map(map)
+        , m_Heuristic(heuristic)
+        , m_Space(map)
+        , m_Weight(WEIGHT_ONE)
+    {
+
+    }
+
+    void setSuboptimalityBound(double epsilon)
+    {
+        // Rounded down so the weight never exceeds 1 + epsilon
+        m_Weight = static_cast<int>(std::floor((1.0 + epsilon) * WEIGHT_ONE));
+    }
+
+    bool findPath(const Point& start, const Point& goal) override
+    {
+        prepare();
+
+        auto startCell = m_Map.getCellIndex(start);
+        auto goalCell = m_Map.getCellIndex(goal);
+        if (m_Map.isWall(startCell) || m_Map.isWall(goalCell))
+            return false;
+
+        auto& startNode = m_Space.getNode(startCell);
+        startNode.parent = -1;
+        startNode.movementCost = 0;
+        m_Space.setState(startCell, CellState::Open);
+        m_OpenSet.push(startCell, { calculateScore(0, start, goal), 0 });
+
+        auto directions = m_Map.getDirections();
+        auto numDirections = m_Map.getNumDirections();
+
+        while (!m_OpenSet.isEmpty())
+        {
+            auto currentCell = m_OpenSet.pop();
+            auto& currentNode = m_Space.getNode(currentCell);
+            if (currentCell == goalCell)
+            {
+                m_PathCost = currentNode.movementCost;
+                m_Space.buildPath(currentCell, m_Path);
+                return true;
+            }
+
+            m_Space.setState(currentCell, CellState::Closed);
+            ++m_NumExpansions;
+
+            auto currentNodePosition = m_Map.getCellPosition(currentCell);
+            for (int i = 0; i < numDirections; ++i)
+            {
+                // The wall border means a neighbor index is always in range
+                auto direction = directions[i];
+                if (!m_Map.canMove(currentCell, direction))
+                    continue;
+
+                auto neighborCell = currentCell + m_Map.getOffset(direction);
+                auto neighborState = m_Space.getState(neighborCell);
+                if (neighborState == CellState::Closed)
+                    continue;
+
+                auto tentativeMovementCost = currentNode.movementCost + Cost::getStepCost(direction);
+
+                bool neighborInOpenSet = (neighborState == CellState::Open);
+                auto& neighborNode = m_Space.getNode(neighborCell);
+                if (!neighborInOpenSet || (tentativeMovementCost < neighborNode.movementCost))
+                {
+                    neighborNode.parent = currentCell;
+                    neighborNode.movementCost = tentativeMovementCost;
+
+                    auto neighborPosition = m_Map.getAdjacentNode(currentNodePosition, direction);
+                    SearchKey key = { calculateScore(tentativeMovementCost, neighborPosition, goal),
+                                      tentativeMovementCost };
+                    if (neighborInOpenSet)
+                    {
+                        m_OpenSet.decreaseKey(neighborCell, key);
+                    }
+                    else
+                    {
+                        m_OpenSet.push(neighborCell, key);
+                        m_Space.setState(neighborCell, CellState::Open);
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+private:
+    // Fixed point scale of the heuristic weight
+    static const int WEIGHT_ONE = 1024;
+
+    void prepare()
+    {
+        m_Space.prepare();
+
+        if (m_OpenSet.getCapacity() != m_Map.getNumCells())
+            m_OpenSet.resize(m_Map.getNumCells());
+
+        m_OpenSet.clear();
+        m_Path.clear();
+        m_PathCost = 0;
+        m_NumExpansions = 0;
+    }
+
+    int calculateScore(int movementCost, const Point& from, const Point& goal) const
+    {
+        auto heuristicCost = m_Heuristic(from, goal);
+        if (m_Weight == WEIGHT_ONE)
+            return movementCost + heuristicCost;
+
+        return movementCost + static_cast<int>((static_cast<std::int64_t>(heuristicCost) * m_Weight) / WEIGHT_ONE);
+    }
+
+private:
+    const GridMap& m_Map;
+    Heuristic m_Heuristic;
+
+    SearchSpace m_Space;
+    OpenList m_OpenSet;
+
+    int m_Weight;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef BENCHMARKMAPLOADER_HPP
+#define BENCHMARKMAPLOADER_HPP
+
+#include "core/GridMap.hpp"
+
+#include <string>
+
+// Reads a map in the MovingAI benchmark .map format: a header giving
+// the type, height and width, then a "map" line and one line of
+// characters per row.
+//
+// '.', 'G' and 'S' are passable and everything else is a wall, missing
+// characters included. The benchmarks move in 8 directions without
+// cutting corners, so the map is set up that way.
+class BenchmarkMapLoader
+{
+public:
+    explicit BenchmarkMapLoader(const std::string& file);
+
+    // Whether the file starts with a .map header
+    static bool isBenchmarkMap(const std::string& file);
+
+    bool load(GridMap& map) const;
+
+private:
+    std::string m_File;
+};
+
+#endif
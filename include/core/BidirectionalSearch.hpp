@@ -0,0 +1,226 @@
+#ifndef BIDIRECTIONALSEARCH_HPP
+#define BIDIRECTIONALSEARCH_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Heuristics.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/SearchSpace.hpp"
+
+#include <climits>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+// Bidirectional A* over a GridMap: one search forwards from the start and
+// one backwards from the goal, meeting in the middle.
+//
+// Both sides use the average of the two heuristics as their potential,
+// p(n) = (h(n, goal) - h(n, start)) / 2 going forwards and -p(n) going
+// backwards. That makes each side a Dijkstra search over the same
+// reduced step costs, so the textbook stopping rule holds: once the two
+// lowest keys add up to the best path found so far, no path through any
+// unexpanded node can beat it. (Giving each side its own heuristic only
+// allows stopping when one side's lowest score reaches the best path,
+// by which time that side has done all the work of plain A*.) Keys are
+// doubled to keep them integers.
+//
+// Whenever a side reaches a cell the other has already reached, the two
+// halves form a path, and the cheapest such path is kept and spliced at
+// that cell. Moves on a GridMap are symmetric under every corner cutting
+// rule, so the backward side uses the same neighbours as the forward one.
+template <typename Heuristic, typename Cost = GridCost>
+class BidirectionalSearch : public Pathfinder
+{
+    static_assert(std::is_same<typename Heuristic::Cost, Cost>::value,
+                  "The heuristic must estimate the same cost policy the search uses");
+
+public:
+    explicit BidirectionalSearch(const GridMap& map, const Heuristic& heuristic = Heuristic())
+        : m_Map(map)
+        , m_Heuristic(heuristic)
+        , m_Forward(map)
+        , m_Backward(map)
+    {
+
+    }
+
+    bool findPath(const Point& start, const Point& goal) override
+    {
+        prepare();
+
+        auto startCell = m_Map.getCellIndex(start);
+        auto goalCell = m_Map.getCellIndex(goal);
+        if (m_Map.isWall(startCell) || m_Map.isWall(goalCell))
+            return false;
+
+        m_Forward.begin(startCell, getPotential(start, goal, start));
+        m_Backward.begin(goalCell, getPotential(goal, start, goal));
+
+        m_BestCost = (startCell == goalCell) ? 0 : INT_MAX;
+        m_MeetingCell = (startCell == goalCell) ? startCell : -1;
+
+        while (!m_Forward.openSet.isEmpty() && !m_Backward.openSet.isEmpty())
+        {
+            auto forwardKey = m_Forward.getLowestKey();
+            auto backwardKey = m_Backward.getLowestKey();
+            if (static_cast<long long>(forwardKey) + backwardKey >= 2LL * m_BestCost)
+                break;
+
+            if (forwardKey <= backwardKey)
+                expand(m_Forward, m_Backward, goal, start);
+            else
+                expand(m_Backward, m_Forward, start, goal);
+        }
+
+        if (m_MeetingCell == -1)
+            return false;
+
+        m_PathCost = m_BestCost;
+        buildPath();
+
+        return true;
+    }
+
+private:
+    // One direction of the search, rooted at the start or the goal
+    struct Side
+    {
+        explicit Side(const GridMap& map)
+            : space(map)
+        {
+
+        }
+
+        void begin(int rootCell, int score)
+        {
+            auto& root = space.getNode(rootCell);
+            root.parent = -1;
+            root.movementCost = 0;
+            space.setState(rootCell, CellState::Open);
+            openSet.push(rootCell, { score, 0 });
+        }
+
+        int getLowestKey() const
+        {
+            return openSet.getKey(openSet.top()).score;
+        }
+
+        bool hasReached(int cell) const
+        {
+            auto state = space.getState(cell);
+
+            return (state == CellState::Open) || (state == CellState::Closed);
+        }
+
+        SearchSpace space;
+        BinaryHeap<SearchKey> openSet;
+    };
+
+    void prepare()
+    {
+        for (auto side : { &m_Forward, &m_Backward })
+        {
+            side->space.prepare();
+
+            if (side->openSet.getCapacity() != m_Map.getNumCells())
+                side->openSet.resize(m_Map.getNumCells());
+
+            side->openSet.clear();
+        }
+
+        m_Path.clear();
+        m_PathCost = 0;
+        m_NumExpansions = 0;
+    }
+
+    // Twice the potential of position for the side searching from source
+    // towards target
+    int getPotential(const Point& position, const Point& target, const Point& source) const
+    {
+        return m_Heuristic(position, target) - m_Heuristic(position, source);
+    }
+
+    // Expands the best node of side, searching from source towards target
+    void expand(Side& side, const Side& other, const Point& target, const Point& source)
+    {
+        auto currentCell = side.openSet.pop();
+        auto& currentNode = side.space.getNode(currentCell);
+        side.space.setState(currentCell, CellState::Closed);
+        ++m_NumExpansions;
+
+        auto currentPosition = m_Map.getCellPosition(currentCell);
+        auto directions = m_Map.getDirections();
+        auto numDirections = m_Map.getNumDirections();
+        for (int i = 0; i < numDirections; ++i)
+        {
+            auto direction = directions[i];
+            if (!m_Map.canMove(currentCell, direction))
+                continue;
+
+            auto neighborCell = currentCell + m_Map.getOffset(direction);
+            auto neighborState = side.space.getState(neighborCell);
+            if (neighborState == CellState::Closed)
+                continue;
+
+            auto tentativeMovementCost = currentNode.movementCost + Cost::getStepCost(direction);
+
+            bool neighborInOpenSet = (neighborState == CellState::Open);
+            auto& neighborNode = side.space.getNode(neighborCell);
+            if (neighborInOpenSet && (tentativeMovementCost >= neighborNode.movementCost))
+                continue;
+
+            if (other.hasReached(neighborCell))
+            {
+                auto pathCost = tentativeMovementCost + other.space.getNode(neighborCell).movementCost;
+                if (pathCost < m_BestCost)
+                {
+                    m_BestCost = pathCost;
+                    m_MeetingCell = neighborCell;
+                }
+            }
+
+            auto neighborPosition = m_Map.getAdjacentNode(currentPosition, direction);
+            SearchKey key = { 2 * tentativeMovementCost + getPotential(neighborPosition, target, source),
+                              tentativeMovementCost };
+
+            neighborNode.parent = currentCell;
+            neighborNode.movementCost = tentativeMovementCost;
+
+            if (neighborInOpenSet)
+            {
+                side.openSet.decreaseKey(neighborCell, key);
+            }
+            else
+            {
+                side.openSet.push(neighborCell, key);
+                side.space.setState(neighborCell, CellState::Open);
+            }
+        }
+    }
+
+    // Joins the forward half, start to meeting cell, with the backward
+    // half, meeting cell to goal
+    void buildPath()
+    {
+        m_Forward.space.buildPath(m_MeetingCell, m_Path);
+        m_Backward.space.buildPath(m_MeetingCell, m_BackwardPath);
+
+        // The backward half runs goal first and shares the meeting cell
+        m_Path.insert(m_Path.end(), m_BackwardPath.rbegin() + 1, m_BackwardPath.rend());
+    }
+
+private:
+    const GridMap& m_Map;
+    Heuristic m_Heuristic;
+
+    Side m_Forward;
+    Side m_Backward;
+
+    int m_BestCost;
+    int m_MeetingCell;
+
+    std::vector<Point> m_BackwardPath;
+};
+
+#endif
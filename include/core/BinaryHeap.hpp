@@ -0,0 +1,224 @@
+#ifndef BINARYHEAP_HPP
+#define BINARYHEAP_HPP
+
+#include <cassert>
+#include <vector>
+
+// Priority of a node in the open set. Nodes with the lowest score come
+// first; ties go to the node with the higher movement cost, which is the
+// one that has made the most progress towards the goal.
+struct SearchKey
+{
+    int score;
+    int movementCost;
+
+    bool operator<(const SearchKey& other) const
+    {
+        if (score != other.score)
+            return score < other.score;
+
+        return movementCost > other.movementCost;
+    }
+};
+
+// Binary min-heap over cell indices with an index table, so membership
+// tests are O(1) and push, pop, remove and key changes are O(log n).
+// The index table is validated against the entries instead of being
+// wiped, so clearing the heap costs O(1) whatever its size.
+template <typename Key>
+class BinaryHeap
+{
+public:
+    explicit BinaryHeap(int numCells = 0)
+        : m_Indices(numCells, -1)
+    {
+
+    }
+
+    void resize(int numCells)
+    {
+        m_Entries.clear();
+        m_Indices.assign(numCells, -1);
+    }
+
+    void clear()
+    {
+        m_Entries.clear();
+    }
+
+    bool isEmpty() const
+    {
+        return m_Entries.empty();
+    }
+
+    int getSize() const
+    {
+        return m_Entries.size();
+    }
+
+    // The number of cell indices the heap can hold
+    int getCapacity() const
+    {
+        return m_Indices.size();
+    }
+
+    bool contains(int cell) const
+    {
+        auto index = m_Indices[cell];
+
+        return (index >= 0) && (index < static_cast<int>(m_Entries.size()))
+            && (m_Entries[index].cell == cell);
+    }
+
+    const Key& getKey(int cell) const
+    {
+        assert(contains(cell));
+
+        return m_Entries[m_Indices[cell]].key;
+    }
+
+    int top() const
+    {
+        assert(!isEmpty());
+
+        return m_Entries[0].cell;
+    }
+
+    void push(int cell, const Key& key)
+    {
+        assert(!contains(cell));
+
+        m_Entries.push_back({ key, cell });
+        m_Indices[cell] = m_Entries.size() - 1;
+        siftUp(m_Entries.size() - 1);
+    }
+
+    int pop()
+    {
+        assert(!isEmpty());
+
+        auto cell = m_Entries[0].cell;
+
+        if (m_Entries.size() > 1)
+        {
+            m_Entries[0] = m_Entries.back();
+            m_Indices[m_Entries[0].cell] = 0;
+            m_Entries.pop_back();
+            siftDown(0);
+        }
+        else
+        {
+            m_Entries.pop_back();
+        }
+
+        return cell;
+    }
+
+    void decreaseKey(int cell, const Key& key)
+    {
+        assert(contains(cell));
+
+        auto index = m_Indices[cell];
+        m_Entries[index].key = key;
+        siftUp(index);
+    }
+
+    // Moves cell to its place for a key that may be higher or lower
+    void updateKey(int cell, const Key& key)
+    {
+        assert(contains(cell));
+
+        auto index = m_Indices[cell];
+        m_Entries[index].key = key;
+        siftUp(index);
+        siftDown(m_Indices[cell]);
+    }
+
+    void remove(int cell)
+    {
+        assert(contains(cell));
+
+        auto index = m_Indices[cell];
+        auto last = m_Entries.back();
+        m_Entries.pop_back();
+
+        if (index < static_cast<int>(m_Entries.size()))
+        {
+            place(index, last);
+            siftUp(index);
+            siftDown(m_Indices[last.cell]);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        int cell;
+    };
+
+    // Equal keys fall back to the cell index so the pop order never
+    // depends on the order nodes were pushed in
+    bool isBefore(const Entry& lhs, const Entry& rhs) const
+    {
+        if (lhs.key < rhs.key)
+            return true;
+        if (rhs.key < lhs.key)
+            return false;
+
+        return lhs.cell < rhs.cell;
+    }
+
+    void siftUp(int index)
+    {
+        auto entry = m_Entries[index];
+
+        while (index > 0)
+        {
+            auto parent = (index - 1) / 2;
+            if (!isBefore(entry, m_Entries[parent]))
+                break;
+
+            place(index, m_Entries[parent]);
+            index = parent;
+        }
+
+        place(index, entry);
+    }
+
+    void siftDown(int index)
+    {
+        auto entry = m_Entries[index];
+        int size = m_Entries.size();
+
+        while (true)
+        {
+            auto child = index * 2 + 1;
+            if (child >= size)
+                break;
+
+            if ((child + 1 < size) && isBefore(m_Entries[child + 1], m_Entries[child]))
+                ++child;
+
+            if (!isBefore(m_Entries[child], entry))
+                break;
+
+            place(index, m_Entries[child]);
+            index = child;
+        }
+
+        place(index, entry);
+    }
+
+    void place(int index, const Entry& entry)
+    {
+        m_Entries[index] = entry;
+        m_Indices[entry.cell] = index;
+    }
+
+private:
+    std::vector<Entry> m_Entries;
+    std::vector<int> m_Indices;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef BITGRID_HPP
+#define BITGRID_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// One bit per cell, packed 64 cells to a word. Every row starts on a
+// word boundary so whole rows can be filled or cleared a word at a time.
+//
+// Bits can also be addressed by index, y * getStride() + x, which maps
+// straight onto the packed words without any division.
+//
+// The words are normally owned, but a grid can instead view words kept
+// elsewhere, such as a mapped file. A view writes through to them, and
+// they must outlive it or the next resize.
+class BitGrid
+{
+public:
+    typedef std::uint64_t Word;
+
+    static const int BITS_PER_WORD = 64;
+
+    // Walks the set bits in row-major order, yielding their indices
+    class Iterator : public std::iterator<std::forward_iterator_tag, int>
+    {
+    public:
+        Iterator(const BitGrid& grid, int wordIndex);
+
+        int operator*() const;
+        Iterator& operator++();
+
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        void skipEmptyWords();
+
+    private:
+        const BitGrid* m_Grid;
+        int m_WordIndex;
+        Word m_Remaining;
+    };
+
+public:
+    BitGrid();
+    BitGrid(int width, int height);
+
+    // A copy of a view views the same words
+    BitGrid(const BitGrid& other);
+    BitGrid& operator=(const BitGrid& other);
+
+    void resize(int width, int height);
+
+    // Views getWordsPerRow() * height words laid out as this would lay
+    // them out itself
+    void view(int width, int height, Word* words);
+    bool isView() const;
+
+    int getWidth() const;
+    int getHeight() const;
+    int getWordsPerRow() const;
+    int getStride() const;
+
+    bool test(int x, int y) const;
+    void set(int x, int y);
+    void clear(int x, int y);
+
+    bool test(int index) const;
+    void set(int index);
+    void clear(int index);
+
+    // Operate on the half-open range [beginX, endX) of row y
+    void fillRow(int y, int beginX, int endX);
+    void clearRow(int y, int beginX, int endX);
+
+    void clearAll();
+    int count() const;
+
+    // The packed rows, getWordsPerRow() words each
+    const Word* getWords() const;
+    int getNumWords() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    int getWordIndex(int x, int y) const;
+    static Word getBitMask(int x);
+    static Word getRangeMask(int beginBit, int endBit);
+
+private:
+    int m_Width;
+    int m_Height;
+    int m_WordsPerRow;
+
+    // Points into m_Words unless this is a view
+    std::vector<Word> m_Words;
+    Word* m_Data;
+    bool m_IsView;
+};
+
+#endif
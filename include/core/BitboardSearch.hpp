@@ -0,0 +1,70 @@
+#ifndef BITBOARDSEARCH_HPP
+#define BITBOARDSEARCH_HPP
+
+#include "core/BitGrid.hpp"
+#include "core/GridMap.hpp"
+
+#include <vector>
+
+// Breadth-first search on a 4-connected map that moves a whole frontier
+// at once. The passable cells and the frontier are bitboards in the
+// GridMap's padded word layout, and each step is a handful of shifts,
+// ANDs and ORs per word, so 64 cells advance per operation. On x86 CPUs
+// with AVX2 four words are done per instruction; the CPU is checked at
+// run time, so no build flags are needed.
+//
+// It answers reachability and unit step distance only; use a Pathfinder
+// for the path itself. Diagonal movement is ignored.
+class BitboardSearch
+{
+public:
+    explicit BitboardSearch(const GridMap& map);
+
+    bool isReachable(const Point& start, const Point& goal);
+
+    // The number of steps on a shortest 4-connected path, or -1
+    int getDistance(const Point& start, const Point& goal);
+
+    // Whether this CPU runs the AVX2 loop
+    bool usesAvx2() const;
+
+private:
+    typedef BitGrid::Word Word;
+
+    // A bitboard and the rows [beginRow, endRow) that may have bits set;
+    // every other row is zero
+    struct Layer
+    {
+        std::vector<Word> words;
+        int beginRow;
+        int endRow;
+    };
+
+    void prepare();
+
+    // Writes the cells one step on from m_Frontier that are neither
+    // walls nor in m_Previous to m_Next, for rows [beginRow, endRow)
+    void expand(int beginRow, int endRow);
+
+    // Shrinks the row range of layer to its non-empty rows. Returns
+    // false if it is empty.
+    bool trimRows(Layer& layer) const;
+
+private:
+    const GridMap& m_Map;
+
+    unsigned m_Revision;
+    bool m_IsPrepared;
+    int m_WordsPerRow;
+    bool m_UsesAvx2;
+
+    // On a 4-connected grid every neighbour of a BFS layer is in the
+    // layer before or the layer after, so the previous layer is all that
+    // has to be masked out and no visited set is needed
+    std::vector<Word> m_Passable;
+    Layer m_Previous;
+    Layer m_Frontier;
+    Layer m_Next;
+};
+
+#endif
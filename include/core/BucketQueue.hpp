@@ -0,0 +1,236 @@
+#ifndef BUCKETQUEUE_HPP
+#define BUCKETQUEUE_HPP
+
+#include "core/BinaryHeap.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// Open set for integer scores that stay within a narrow window, as they
+// do in A* with small step costs: one bucket per score, held in a ring.
+// push and decreaseKey are O(1) and pop is amortized O(1), scanning
+// forward from the lowest score still queued.
+//
+// Each bucket is an intrusive doubly linked list threaded through per
+// cell arrays, so moving a node between buckets needs no allocation.
+// Ties within a score pop the most recently pushed node first, which in
+// A* tends to favour the deepest node much like the heap's tie-break.
+//
+// Scores below the lowest one queued are accepted (weighted A* produces
+// them), and the ring doubles whenever a score falls outside it.
+// Offers the same interface as BinaryHeap<SearchKey>.
+class BucketQueue
+{
+public:
+    explicit BucketQueue(int numCells = 0)
+        : m_NumEntries(0)
+        , m_MinScore(0)
+        , m_MaxScore(0)
+        , m_Generation(1)
+    {
+        resize(numCells);
+    }
+
+    void resize(int numCells)
+    {
+        m_Cells.assign(numCells, { { 0, 0 }, -1, -1, 0 });
+        m_Buckets.assign(INITIAL_BUCKETS, -1);
+        m_NumEntries = 0;
+        m_Generation = 1;
+    }
+
+    // O(1): the cells still linked in are told apart by their stamp, and
+    // the buckets are emptied as the queue drains
+    void clear()
+    {
+        if (m_NumEntries > 0)
+            m_Buckets.assign(m_Buckets.size(), -1);
+
+        m_NumEntries = 0;
+
+        ++m_Generation;
+        if (m_Generation == 0)
+        {
+            for (auto& cell : m_Cells)
+                cell.stamp = 0;
+
+            m_Generation = 1;
+        }
+    }
+
+    bool isEmpty() const
+    {
+        return m_NumEntries == 0;
+    }
+
+    int getSize() const
+    {
+        return m_NumEntries;
+    }
+
+    int getCapacity() const
+    {
+        return m_Cells.size();
+    }
+
+    bool contains(int cell) const
+    {
+        return m_Cells[cell].stamp == m_Generation;
+    }
+
+    const SearchKey& getKey(int cell) const
+    {
+        assert(contains(cell));
+
+        return m_Cells[cell].key;
+    }
+
+    int top() const
+    {
+        assert(!isEmpty());
+
+        auto score = m_MinScore;
+        while (m_Buckets[getBucket(score)] == -1)
+            ++score;
+
+        return m_Buckets[getBucket(score)];
+    }
+
+    void push(int cell, const SearchKey& key)
+    {
+        assert(!contains(cell));
+
+        m_Cells[cell].stamp = m_Generation;
+        ++m_NumEntries;
+        link(cell, key);
+    }
+
+    int pop()
+    {
+        assert(!isEmpty());
+
+        while (m_Buckets[getBucket(m_MinScore)] == -1)
+            ++m_MinScore;
+
+        auto cell = m_Buckets[getBucket(m_MinScore)];
+        unlink(cell);
+        m_Cells[cell].stamp = 0;
+        --m_NumEntries;
+
+        return cell;
+    }
+
+    void decreaseKey(int cell, const SearchKey& key)
+    {
+        assert(contains(cell));
+
+        unlink(cell);
+        link(cell, key);
+    }
+
+private:
+    static const int INITIAL_BUCKETS = 64;
+
+    struct Cell
+    {
+        SearchKey key;
+        int next;
+        int previous;
+        std::uint32_t stamp;
+    };
+
+    int getBucket(int score) const
+    {
+        // The ring size is a power of two
+        return score & (static_cast<int>(m_Buckets.size()) - 1);
+    }
+
+    void link(int cell, const SearchKey& key)
+    {
+        // The first node in sets the window; m_NumEntries already counts it
+        if (m_NumEntries == 1)
+        {
+            m_MinScore = key.score;
+            m_MaxScore = key.score;
+        }
+        else
+        {
+            auto minScore = (key.score < m_MinScore) ? key.score : m_MinScore;
+            auto maxScore = (key.score > m_MaxScore) ? key.score : m_MaxScore;
+            if (maxScore - minScore >= static_cast<int>(m_Buckets.size()))
+                grow(maxScore - minScore + 1);
+
+            m_MinScore = minScore;
+            m_MaxScore = maxScore;
+        }
+
+        auto& bucket = m_Buckets[getBucket(key.score)];
+        auto& node = m_Cells[cell];
+        node.key = key;
+        node.previous = -1;
+        node.next = bucket;
+        if (bucket != -1)
+            m_Cells[bucket].previous = cell;
+
+        bucket = cell;
+    }
+
+    void unlink(int cell)
+    {
+        auto& node = m_Cells[cell];
+        if (node.previous != -1)
+            m_Cells[node.previous].next = node.next;
+        else
+            m_Buckets[getBucket(node.key.score)] = node.next;
+
+        if (node.next != -1)
+            m_Cells[node.next].previous = node.previous;
+    }
+
+    // Rehashes every queued cell into a ring of at least minBuckets
+    void grow(int minBuckets)
+    {
+        auto numBuckets = m_Buckets.size();
+        while (numBuckets < static_cast<std::size_t>(minBuckets))
+            numBuckets *= 2;
+
+        std::vector<int> queued;
+        queued.reserve(m_NumEntries);
+        for (auto head : m_Buckets)
+        {
+            for (auto cell = head; cell != -1; cell = m_Cells[cell].next)
+                queued.push_back(cell);
+        }
+
+        m_Buckets.assign(numBuckets, -1);
+
+        // Re-link in reverse so each bucket keeps its order
+        for (auto it = queued.rbegin(); it != queued.rend(); ++it)
+        {
+            auto& node = m_Cells[*it];
+            auto& bucket = m_Buckets[getBucket(node.key.score)];
+            node.previous = -1;
+            node.next = bucket;
+            if (bucket != -1)
+                m_Cells[bucket].previous = *it;
+
+            bucket = *it;
+        }
+    }
+
+private:
+    std::vector<Cell> m_Cells;
+    std::vector<int> m_Buckets;
+
+    int m_NumEntries;
+
+    // Every queued score lies in [m_MinScore, m_MaxScore]. The bounds are
+    // only tightened by pop, so they may be looser than that.
+    int m_MinScore;
+    int m_MaxScore;
+
+    std::uint32_t m_Generation;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef CONNECTEDCOMPONENTS_HPP
+#define CONNECTEDCOMPONENTS_HPP
+
+#include "core/GridMap.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Labels the free cells of a GridMap by the region they belong to, so a
+// query between two regions can be turned down without a search.
+//
+// The labels are a union-find forest over cell indices, built with one
+// pass over the map under its movement rules. Removing a wall only joins
+// regions, so it is patched in place by uniting the cell with its
+// neighbours. Adding a wall is patched in place only if a breadth first
+// search of at most MAX_LOCAL_SEARCH cells shows its free neighbours
+// still reach each other, which leaves the region whole. Union-find
+// cannot undo a join, so a wall that may cut a region in two costs a
+// full relabel of the map on the next query, as does any other change.
+class ConnectedComponents : public MapListener
+{
+public:
+    explicit ConnectedComponents(const GridMap& map);
+    ~ConnectedComponents();
+
+    ConnectedComponents(const ConnectedComponents&) = delete;
+    ConnectedComponents& operator=(const ConnectedComponents&) = delete;
+
+    // False only if there is certainly no path between the two cells
+    bool mayBeConnected(const Point& from, const Point& to);
+
+    // Forces a rebuild on next use
+    void invalidate();
+
+    // Rebuilds the labels now if they are stale, rather than on next use
+    void update();
+
+    void onWallAdded(const Point& position) override;
+    void onWallRemoved(const Point& position) override;
+    void onMapChanged() override;
+
+private:
+    static const int MAX_LOCAL_SEARCH;
+
+    void rebuild();
+
+    // Whether the free neighbours of a new wall still share its region
+    bool isRegionWhole(int cell);
+
+    int find(int cell);
+    void unite(int first, int second);
+
+private:
+    const GridMap& m_Map;
+
+    std::vector<int> m_Parents;
+
+    // Walls added since the last rebuild keep their place in the forest,
+    // as cells may point through them, and so keep their old label
+    std::vector<bool> m_IsLabelledWall;
+
+    // Breadth first search state for isRegionWhole
+    std::vector<int> m_Queue;
+    std::vector<std::uint32_t> m_Marks;
+    std::uint32_t m_Generation;
+
+    // The map revision the labels match
+    unsigned m_Revision;
+    bool m_IsStale;
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef CORRIDORSEARCH_HPP
+#define CORRIDORSEARCH_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/SearchSpace.hpp"
+
+#include <vector>
+
+// A* over a GridMap with its corridors contracted into single edges.
+//
+// A free cell with exactly two moves out of it is a corridor cell: a
+// path through it comes in one way and leaves the other. Every other
+// free cell, a junction or a dead end, is a node, and each run of
+// corridor cells between two nodes becomes one edge weighted with the
+// cost of walking it. A loop made only of corridor cells gets one of its
+// cells promoted to a node. A query links a start or goal inside a
+// corridor to the two ends of its corridor, searches the node graph and
+// then walks each edge of the result back out into cells.
+//
+// On maps that are mostly one cell wide corridors, such as mazes, the
+// graph is far smaller than the grid. On open maps nearly every cell is
+// a junction and nothing is gained. The graph is rebuilt on the first
+// query after any change to the map.
+class CorridorSearch : public Pathfinder, public MapListener
+{
+public:
+    explicit CorridorSearch(const GridMap& map);
+    ~CorridorSearch();
+
+    CorridorSearch(const CorridorSearch&) = delete;
+    CorridorSearch& operator=(const CorridorSearch&) = delete;
+
+    bool findPath(const Point& start, const Point& goal) override;
+
+    void onWallAdded(const Point& position) override;
+    void onWallRemoved(const Point& position) override;
+    void onMapChanged() override;
+
+    int getNumNodes() const;
+    int getNumEdges() const;
+
+private:
+    // A corridor from one node to another, or the same one for a loop.
+    // Its cells, ends included, are numbered 0 to getLength() - 1.
+    struct Edge
+    {
+        int from;
+        int to;
+        int cost;
+
+        // The corridor cells, ends excluded, in m_CorridorCells
+        int cellsBegin;
+        int cellsEnd;
+
+        int getLength() const
+        {
+            return cellsEnd - cellsBegin + 2;
+        }
+    };
+
+    // Part of an edge walked in one step of the graph search, from cell
+    // number begin to cell number end
+    struct Step
+    {
+        int edge;
+        int begin;
+        int end;
+    };
+
+    void build();
+    int getNumMoves(int cell) const;
+    void walkCorridor(int node, Direction direction);
+
+    int getCell(const Edge& edge, int number) const;
+
+    void relax(int currentCell, int neighborCell, int cost, const Step& step);
+    void expandNode(int cell);
+    void expandCorridorCell(int cell);
+
+    void buildPath();
+    int getHeuristic(int from, int to) const;
+
+private:
+    const GridMap& m_Map;
+    bool m_IsStale;
+
+    int m_NumNodes;
+    std::vector<Edge> m_Edges;
+    std::vector<int> m_CorridorCells;
+
+    // Edges leaving node cell c are m_AdjacentEdges[m_AdjacencyStarts[c]]
+    // up to m_AdjacencyStarts[c + 1]; the array is empty for other cells
+    std::vector<int> m_AdjacencyStarts;
+    std::vector<int> m_AdjacentEdges;
+
+    // The edge each corridor cell is on, or -1 for nodes and walls, with
+    // its number along the edge and the cost of reaching it from the
+    // edge's first node
+    std::vector<int> m_CellEdges;
+    std::vector<int> m_CellNumbers;
+    std::vector<int> m_CellCosts;
+
+    int m_StartCell;
+    int m_GoalCell;
+    SearchSpace m_Space;
+    BinaryHeap<SearchKey> m_OpenSet;
+
+    // The step that reached each cell in the graph search
+    std::vector<Step> m_ParentSteps;
+    std::vector<Step> m_PathSteps;
+};
+
+#endif
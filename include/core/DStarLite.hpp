@@ -0,0 +1,87 @@
+#ifndef DSTARLITE_HPP
+#define DSTARLITE_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Pathfinder.hpp"
+
+#include <vector>
+
+// Priority of a cell in D* Lite: the lower of its two cost estimates plus
+// the heuristic, then the lower estimate alone
+struct ReplanKey
+{
+    int primary;
+    int secondary;
+
+    bool operator<(const ReplanKey& other) const
+    {
+        if (primary != other.primary)
+            return primary < other.primary;
+
+        return secondary < other.secondary;
+    }
+};
+
+// D* Lite incremental replanning over a GridMap with GridCost steps.
+//
+// The search runs backwards from the goal and keeps its costs between
+// calls. Wall edits reported by the map only mark the cells around them
+// as out of date, and the next findPath repairs costs outward from those
+// cells until the start's path is settled again, instead of searching
+// from scratch. The start may move between calls; a new goal, or any
+// change the map reports as onMapChanged, starts over.
+//
+// Every cell has a cost estimate g and a one step lookahead rhs, the
+// cheapest step to a neighbour plus that neighbour's g. A cell is
+// consistent when the two agree, and only inconsistent cells are queued.
+class DStarLite : public Pathfinder, public MapListener
+{
+public:
+    explicit DStarLite(const GridMap& map);
+    ~DStarLite();
+
+    DStarLite(const DStarLite&) = delete;
+    DStarLite& operator=(const DStarLite&) = delete;
+
+    bool findPath(const Point& start, const Point& goal) override;
+
+    void onWallAdded(const Point& position) override;
+    void onWallRemoved(const Point& position) override;
+    void onMapChanged() override;
+
+private:
+    void reset(int goalCell);
+
+    void computeShortestPath();
+    void updateCell(int cell);
+    void updateLookahead(int cell);
+
+    ReplanKey calculateKey(int cell) const;
+    int getHeuristic(int from, int to) const;
+
+    // False if the walk from the start does not reach the goal
+    bool buildPath();
+
+private:
+    static const int INFINITE_COST;
+
+    const GridMap& m_Map;
+
+    std::vector<int> m_Costs;
+    std::vector<int> m_Lookaheads;
+    BinaryHeap<ReplanKey> m_OpenSet;
+
+    bool m_NeedsReset;
+    int m_StartCell;
+    int m_GoalCell;
+
+    // Added to every key as the start moves, instead of re-keying the
+    // whole open set
+    int m_KeyModifier;
+
+    // Cells next to walls edited since the last search
+    std::vector<int> m_ChangedCells;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef DEADENDPRUNING_HPP
+#define DEADENDPRUNING_HPP
+
+#include "core/GridMap.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/PathfinderFactory.hpp"
+
+#include <memory>
+#include <vector>
+
+// Runs another search engine over a copy of the map with its dead ends
+// walled off.
+//
+// The free cells are split into blocks, the biconnected components of
+// the map's moves: parts that stay connected whichever single cell is
+// removed. Blocks meet at cut cells, and blocks and cut cells form a
+// tree. A path can only leave a block through a cut cell and cannot come
+// back through it, so a shortest path from start to goal only uses the
+// blocks on the tree path between theirs. Everything else is a dead end
+// for that query: corridors, rooms with a one cell doorway, and whole
+// branches of a maze.
+//
+// The copy keeps the largest block open and walls off the rest. Each
+// query opens the blocks on its tree path and walls them off again
+// afterwards, so a start or goal deep inside a dead end is still found.
+// A cell at the corner of a diagonal move has a straight move to each
+// end of it, so it shares a block with that move and walling off other
+// blocks never blocks a move the path needs.
+//
+// Regions behind a doorway more than one cell wide are not pruned.
+// Engines that keep state from the map (JPS+, HPA*, D* Lite) see every
+// cell opened as a wall edit, so they redo some work on every query.
+class DeadEndPruning : public Pathfinder, public MapListener
+{
+public:
+    DeadEndPruning(const GridMap& map, SearchAlgorithm algorithm);
+    ~DeadEndPruning();
+
+    DeadEndPruning(const DeadEndPruning&) = delete;
+    DeadEndPruning& operator=(const DeadEndPruning&) = delete;
+
+    bool findPath(const Point& start, const Point& goal) override;
+
+    void onWallAdded(const Point& position) override;
+    void onWallRemoved(const Point& position) override;
+    void onMapChanged() override;
+
+    // Free cells walled off when no query is running
+    int getNumPrunedCells() const;
+
+private:
+    void prune();
+    void findBlocks();
+    void addBlock(int topCell, std::vector<int>& stack, int lastCell);
+
+    void openPath(int startBlock, int goalBlock);
+    void openBlock(int block);
+    void closeOpened();
+
+private:
+    const GridMap& m_Map;
+    const SearchAlgorithm m_Algorithm;
+
+    GridMap m_Pruned;
+    bool m_IsStale;
+    int m_NumPrunedCells;
+
+    // Block of each free cell. A cut cell belongs to the block on the
+    // side of the search tree's root.
+    std::vector<int> m_Blocks;
+
+    // Per block: the block it hangs from in the tree, or -1 at the root
+    // of a region, its depth, and its region
+    std::vector<int> m_ParentBlocks;
+    std::vector<int> m_Depths;
+    std::vector<int> m_Regions;
+
+    // The cells of block i, including the cut cell it hangs from, are
+    // m_BlockCells[m_BlockStarts[i]] up to m_BlockStarts[i + 1]
+    std::vector<int> m_BlockStarts;
+    std::vector<int> m_BlockCells;
+
+    int m_LargestBlock;
+
+    // Cells opened for the current query
+    std::vector<Point> m_Opened;
+
+    std::unique_ptr<Pathfinder> m_Search;
+};
+
+#endif
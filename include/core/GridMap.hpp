@@ -0,0 +1,155 @@
+#ifndef GRIDMAP_HPP
+#define GRIDMAP_HPP
+
+#include "core/BitGrid.hpp"
+#include "core/Point.hpp"
+
+#include <vector>
+
+enum class Direction
+{
+    North,
+    NorthEast,
+    East,
+    SouthEast,
+    South,
+    SouthWest,
+    West,
+    NorthWest
+};
+
+enum class Connectivity
+{
+    Four,
+    Eight
+};
+
+// When a diagonal step may pass between walls in the two cells it cuts
+// past: always, unless both are walls, or only if neither is a wall
+enum class CornerCutting
+{
+    Allow,
+    NoSqueeze,
+    Never
+};
+
+// Told about changes to a GridMap, so anything built from it can be
+// patched instead of rebuilt
+class MapListener
+{
+public:
+    virtual ~MapListener()
+    {
+
+    }
+
+    virtual void onWallAdded(const Point& position) = 0;
+    virtual void onWallRemoved(const Point& position) = 0;
+
+    // Any other change: a resize, wall rows, clearing the walls or new
+    // movement rules
+    virtual void onMapChanged() = 0;
+};
+
+// The walkable layout of a map, without any rendering or search state.
+//
+// The map is stored with a one cell wall border around it, and cell
+// indices address that padded layout: index = (y + 1) * stride + (x + 1).
+// Stepping in a Direction is then a fixed offset, and the border stops a
+// search from ever walking off the map without any edge checks.
+//
+// The stride is the wall bitboard's row, a whole number of 64-bit words,
+// so every per-cell array also pays for the border and the padding: up
+// to 65 extra cells a row, plus the two border rows. A row holds 64
+// times the map's cells at width 1, 2.03 times at width 63 and at most
+// 1.07 times from width 1000 on. Per padded cell, A* keeps 16 bytes (a
+// 12 byte SearchNode and a 4 byte heap index), JPS+ adds 32 for its jump
+// table, a path database 8 for its cell order and regions, and each
+// landmark 4, or 2 when quantized.
+class GridMap
+{
+public:
+    static const Direction CARDINAL_DIRECTIONS[4];
+    static const Direction ALL_DIRECTIONS[8];
+
+public:
+    GridMap();
+    GridMap(int width, int height);
+
+    void resize(int width, int height);
+
+    // Uses walls laid out as getWalls() lays them out, border included,
+    // in place of its own, as BitGrid::view does. Edits write through.
+    void view(int width, int height, BitGrid::Word* walls);
+
+    int getWidth() const;
+    int getHeight() const;
+    int getStride() const;
+
+    // The number of indices in the padded layout, which is the size
+    // needed for any per-cell array
+    int getNumCells() const;
+
+    bool isInside(const Point& position) const;
+    bool isWall(const Point& position) const;
+    bool isWall(int cell) const;
+
+    void addWall(const Point& position);
+    void removeWall(const Point& position);
+    void addWallRow(int y, int beginX, int endX);
+    void clearWalls();
+
+    // Bumped by every change to the walls or movement rules, so anything
+    // precomputed from the map can tell when it is out of date
+    unsigned getRevision() const;
+
+    // Listeners are not owned and must remove themselves before they are
+    // destroyed. They are part of the map's bookkeeping rather than its
+    // contents, so they can be added through a const reference.
+    void addListener(MapListener* listener) const;
+    void removeListener(MapListener* listener) const;
+
+    void setConnectivity(Connectivity connectivity);
+    Connectivity getConnectivity() const;
+    void setCornerCutting(CornerCutting cornerCutting);
+    CornerCutting getCornerCutting() const;
+
+    // The directions a search should try from each cell
+    const Direction* getDirections() const;
+    int getNumDirections() const;
+
+    // Whether a step from cell in direction lands on a free cell without
+    // breaking the corner cutting rule
+    bool canMove(int cell, Direction direction) const;
+
+    // Includes the border, so check positions with isInside
+    const BitGrid& getWalls() const;
+
+    int getCellIndex(const Point& position) const;
+    Point getCellPosition(int cell) const;
+
+    int getOffset(Direction direction) const;
+    static Point getDelta(Direction direction);
+    static bool isDiagonal(Direction direction);
+    Point getAdjacentNode(const Point& from, Direction direction) const;
+
+private:
+    void updateOffsets();
+    void addBorder();
+    void notifyChanged();
+
+private:
+    int m_Width;
+    int m_Height;
+    int m_Offsets[8];
+    unsigned m_Revision;
+
+    Connectivity m_Connectivity;
+    CornerCutting m_CornerCutting;
+
+    BitGrid m_Walls;
+
+    mutable std::vector<MapListener*> m_Listeners;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef HEURISTICS_HPP
+#define HEURISTICS_HPP
+
+#include "core/GridMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Step costs, scaled to integers so every cost and score is an int
+struct GridCost
+{
+    static const int STRAIGHT = 10;
+    static const int DIAGONAL = 14;
+
+    static int getStepCost(Direction direction)
+    {
+        return GridMap::isDiagonal(direction) ? DIAGONAL : STRAIGHT;
+    }
+};
+
+// The same steps a hundred times finer, with the diagonal within 0.002%
+// of sqrt(2). GridCost's 1.4 ties paths whose real lengths differ, such
+// as 5 diagonal steps against 7 straight ones, so the path it picks can
+// be slightly longer; with 1.414 such ties are hundreds of steps apart.
+// Costs stay within an int for paths of up to about 1.5 million steps.
+struct FineGridCost
+{
+    static const int STRAIGHT = 1000;
+    static const int DIAGONAL = 1414;
+
+    static int getStepCost(Direction direction)
+    {
+        return GridMap::isDiagonal(direction) ? DIAGONAL : STRAIGHT;
+    }
+};
+
+// The heuristics below are templated on the cost policy they estimate
+// for, and are all admissible and consistent for it on an open grid.
+
+// Exact on a 4-connected grid
+template <typename CostPolicy>
+struct ManhattanHeuristic
+{
+    typedef CostPolicy Cost;
+
+    int operator()(const Point& from, const Point& to) const
+    {
+        return Cost::STRAIGHT * (std::abs(to.x - from.x) + std::abs(to.y - from.y));
+    }
+};
+
+// Exact on an 8-connected grid: diagonal steps while both axes still
+// need to move, then straight steps for the rest
+template <typename CostPolicy>
+struct OctileHeuristic
+{
+    typedef CostPolicy Cost;
+
+    int operator()(const Point& from, const Point& to) const
+    {
+        auto deltaX = std::abs(to.x - from.x);
+        auto deltaY = std::abs(to.y - from.y);
+        auto diagonalSteps = std::min(deltaX, deltaY);
+        auto straightSteps = std::max(deltaX, deltaY) - diagonalSteps;
+
+        return Cost::DIAGONAL * diagonalSteps + Cost::STRAIGHT * straightSteps;
+    }
+};
+
+// Straight-line distance. Scaled down when the diagonal cost is below
+// STRAIGHT * sqrt(2), as it is for 10/14, so it never overestimates.
+template <typename CostPolicy>
+struct EuclideanHeuristic
+{
+    typedef CostPolicy Cost;
+
+    EuclideanHeuristic()
+        : m_Scale(std::min(static_cast<double>(Cost::STRAIGHT), Cost::DIAGONAL / std::sqrt(2.0)))
+    {
+
+    }
+
+    int operator()(const Point& from, const Point& to) const
+    {
+        double deltaX = to.x - from.x;
+        double deltaY = to.y - from.y;
+
+        return static_cast<int>(m_Scale * std::sqrt(deltaX * deltaX + deltaY * deltaY));
+    }
+
+private:
+    double m_Scale;
+};
+
+// Turns A* into Dijkstra's algorithm
+template <typename CostPolicy>
+struct ZeroHeuristic
+{
+    typedef CostPolicy Cost;
+
+    int operator()(const Point&, const Point&) const
+    {
+        return 0;
+    }
+};
+
+enum class StepCosts
+{
+    // GridCost, 10 and 14
+    Grid,
+
+    // FineGridCost, 1000 and 1414
+    Fine
+};
+
+enum class HeuristicType
+{
+    Manhattan,
+    Octile,
+    Euclidean,
+    Zero
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef HIERARCHICALSEARCH_HPP
+#define HIERARCHICALSEARCH_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/SearchSpace.hpp"
+
+#include <vector>
+
+// HPA*: near-optimal paths over a GridMap split into square clusters.
+//
+// Where two clusters touch, each run of free cells along the shared edge
+// becomes one entrance (two if the run is long), a pair of cells facing
+// each other across it. The entrances of a cluster are linked by their
+// shortest distances inside the cluster, which gives a small abstract
+// graph. A query links the start and goal into the graph with a search
+// of their own clusters, runs A* over the abstract graph and then fills
+// in each step of the abstract path with a search of one cluster, so its
+// cost depends on the path rather than on the size of the map.
+//
+// Paths only cross between clusters through entrances, so they can be
+// slightly longer than optimal. A diagonal step that squeezes between two
+// walls across a cluster edge is the only way through there, so each one
+// becomes an entrance of its own.
+//
+// Wall edits only mark the cluster they fall in as out of date, plus any
+// neighbouring cluster the cell touches. Those are rebuilt on the next
+// query.
+class HierarchicalSearch : public Pathfinder, public MapListener
+{
+public:
+    explicit HierarchicalSearch(const GridMap& map, int clusterSize = 16);
+    ~HierarchicalSearch();
+
+    HierarchicalSearch(const HierarchicalSearch&) = delete;
+    HierarchicalSearch& operator=(const HierarchicalSearch&) = delete;
+
+    bool findPath(const Point& start, const Point& goal) override;
+
+    void onWallAdded(const Point& position) override;
+    void onWallRemoved(const Point& position) override;
+    void onMapChanged() override;
+
+    int getNumEntrances() const;
+
+private:
+    struct Edge
+    {
+        int cell;
+        int cost;
+    };
+
+    struct Entrance
+    {
+        int cell;
+
+        // The cells one step from this one in the neighbouring clusters
+        std::vector<Edge> partners;
+    };
+
+    struct Cluster
+    {
+        Point origin;
+        int width;
+        int height;
+
+        std::vector<Entrance> entrances;
+
+        // Shortest distance inside the cluster between each pair of
+        // entrances, row-major, or UNREACHABLE
+        std::vector<int> distances;
+
+        bool isDirty;
+    };
+
+    void build();
+    void update();
+    void rebuildCluster(int clusterIndex);
+    void addEntrances(int clusterIndex, Direction side);
+
+    int getClusterIndex(const Point& position) const;
+    void markDirty(const Point& position);
+    bool isInCluster(const Cluster& cluster, const Point& position) const;
+
+    // Links the start and goal into the abstract graph. Fills the cost
+    // from the start and to the goal of every entrance in their clusters,
+    // and of the direct route when they share one.
+    void connectEndpoints(int startCell, int goalCell);
+    void getEdges(int cell, std::vector<Edge>& edges) const;
+    bool searchAbstract(int startCell, int goalCell);
+
+    // A* from startCell to goalCell, or Dijkstra over the whole cluster
+    // if goalCell is -1, never leaving the cluster
+    bool searchCluster(const Cluster& cluster, int startCell, int goalCell);
+    void refinePath();
+
+    int getHeuristic(int from, int to) const;
+
+private:
+    static const int UNREACHABLE;
+
+    const GridMap& m_Map;
+    const int m_ClusterSize;
+
+    bool m_IsBuilt;
+    int m_NumClustersX;
+    int m_NumClustersY;
+    std::vector<Cluster> m_Clusters;
+    std::vector<int> m_DirtyClusters;
+
+    // Index of each entrance cell in its cluster's list, otherwise -1
+    std::vector<int> m_EntranceIndices;
+
+    int m_StartCell;
+    int m_GoalCell;
+    std::vector<Edge> m_StartEdges;
+    std::vector<int> m_GoalCosts;
+    int m_DirectCost;
+
+    SearchSpace m_AbstractSpace;
+    BinaryHeap<SearchKey> m_AbstractOpenSet;
+    std::vector<Point> m_AbstractPath;
+    std::vector<Edge> m_Edges;
+
+    SearchSpace m_LocalSpace;
+    BinaryHeap<SearchKey> m_LocalOpenSet;
+    std::vector<Point> m_Segment;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef JUMPPOINTSEARCH_HPP
+#define JUMPPOINTSEARCH_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/SearchSpace.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Jump Point Search over a GridMap with uniform GridCost steps.
+//
+// Instead of pushing every neighbour, each expansion scans along straight
+// and diagonal lines until it reaches a cell where an optimal path may
+// have to turn (a jump point), so only one of the many symmetric paths
+// across an open area is ever looked at. The paths found cost the same
+// as A*'s.
+//
+// On 4-connected maps vertical scans stop wherever a horizontal scan
+// would find a jump point. On 8-connected maps the pruning rules assume
+// diagonal steps never cut a corner, so only CornerCutting::Never is
+// supported there; see isSupported.
+//
+// With precomputed jumps enabled (JPS+) the distance to the next jump
+// point or wall is stored per cell and Direction, so a scan becomes a
+// single lookup. The table is rebuilt whenever the map's revision
+// changes, at O(cells) cost.
+class JumpPointSearch : public Pathfinder
+{
+public:
+    explicit JumpPointSearch(const GridMap& map, bool usePrecomputedJumps = false);
+
+    static bool isSupported(const GridMap& map);
+
+    bool findPath(const Point& start, const Point& goal) override;
+
+private:
+    void prepare();
+
+    // The directions worth scanning from cell, given the direction the
+    // search arrived from. Returns how many were written.
+    int findDirections(int cell, Direction* directions) const;
+
+    // The next jump point from cell going in direction, or -1
+    int jump(int cell, Direction direction, int goalCell) const;
+    int jumpStraight(int cell, int deltaX, int deltaY, int goalCell) const;
+    int jumpPrecomputed(int cell, Direction direction, int goalCell) const;
+
+    bool isForced(int cell, int deltaX, int deltaY) const;
+    bool isFree(int cell) const;
+
+    void precomputeJumps();
+    int& getJumpDistance(int cell, Direction direction);
+    int getJumpDistance(int cell, Direction direction) const;
+
+    int getHeuristic(const Point& from, const Point& to) const;
+
+    // Fills the cells in between consecutive jump points back in
+    void expandPath();
+
+private:
+    const GridMap& m_Map;
+
+    SearchSpace m_Space;
+    BinaryHeap<SearchKey> m_OpenSet;
+
+    bool m_UsePrecomputedJumps;
+    unsigned m_JumpRevision;
+    bool m_HasJumps;
+
+    // Steps to the next jump point if positive, otherwise minus the
+    // number of free steps before a wall. 8 entries per cell.
+    std::vector<std::int32_t> m_JumpDistances;
+
+    std::vector<Point> m_JumpPoints;
+};
+
+#endif
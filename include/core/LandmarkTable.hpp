@@ -0,0 +1,177 @@
+#ifndef LANDMARKTABLE_HPP
+#define LANDMARKTABLE_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/GridMap.hpp"
+#include "core/Heuristics.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+enum class LandmarkStorage
+{
+    // 32 bits per distance
+    Exact,
+
+    // 16 bits per distance, in units of the smallest step that fits the
+    // longest distance
+    Quantized
+};
+
+// Distances from a few landmark cells to every cell of a GridMap, for the
+// ALT (A*, landmarks, triangle inequality) heuristic. For any landmark L
+// the true distance between a and b is at least |d(L, a) - d(L, b)|, and
+// unlike the geometric heuristics that bound sees walls, which is what
+// keeps A* from flooding a maze.
+//
+// Landmarks are picked by farthest point selection: each one is the cell
+// farthest from every landmark before it, with cells no landmark reaches
+// counting as farthest, so every region gets a landmark before any region
+// gets a second one. Building runs one Dijkstra search per landmark over
+// GridCost steps.
+//
+// Quantized storage halves the memory. Every distance is a multiple of
+// the cost granularity (10 on a 4-connected map, 2 on an 8-connected
+// one), so while the longest distance fits in 16 bits in those units it
+// is still exact. Beyond that each distance is rounded down to a coarser
+// unit and the bound gives up one unit to stay admissible. It is then no
+// longer consistent, and A*, which never reopens a closed node, can
+// return a slightly longer path, so exact storage is the default and
+// quantized tables are for when memory matters more than optimality.
+//
+// The table keeps the map revision it was built from and gives no bound
+// once the map has changed, until it is built again.
+class LandmarkTable
+{
+public:
+    // A memory budget in bytes caps the number of landmarks; 0 means no
+    // cap. It covers the finished table: quantized tables are built from
+    // an exact one, which is freed before build returns.
+    explicit LandmarkTable(const GridMap& map, int numLandmarks = 8,
+                           LandmarkStorage storage = LandmarkStorage::Exact,
+                           std::size_t memoryBudget = 0);
+
+    void build();
+
+    // False once the map has changed since the table was built
+    bool isCurrent() const
+    {
+        return m_IsBuilt && (m_Revision == m_Map.getRevision());
+    }
+
+    // False if quantizing rounded any distance
+    bool isLossless() const;
+
+    int getNumLandmarks() const;
+    const std::vector<Point>& getLandmarks() const;
+    std::size_t getMemoryUsage() const;
+
+    // A lower bound on the cost of any path between the two cells
+    int getLowerBound(const Point& from, const Point& to) const
+    {
+        return getLowerBound(m_Map.getCellIndex(from), m_Map.getCellIndex(to));
+    }
+
+    int getLowerBound(int fromCell, int toCell) const
+    {
+        if (m_Storage == LandmarkStorage::Exact)
+            return getLargestDifference(m_ExactDistances, fromCell, toCell, UNREACHABLE_EXACT);
+
+        auto difference = getLargestDifference(m_QuantizedDistances, fromCell, toCell, UNREACHABLE_QUANTIZED);
+        if (m_IsLossless)
+            return difference * m_Unit;
+
+        return std::max(0, difference - 1) * m_Unit;
+    }
+
+private:
+    template <typename Entry>
+    int getLargestDifference(const std::vector<Entry>& distances, int fromCell, int toCell, Entry unreachable) const
+    {
+        auto from = &distances[fromCell * m_NumLandmarks];
+        auto to = &distances[toCell * m_NumLandmarks];
+
+        int largest = 0;
+        for (int i = 0; i < m_NumLandmarks; ++i)
+        {
+            // A landmark that does not reach both cells says nothing
+            if ((from[i] == unreachable) || (to[i] == unreachable))
+                continue;
+
+            largest = std::max(largest, std::abs(static_cast<int>(from[i]) - static_cast<int>(to[i])));
+        }
+
+        return largest;
+    }
+
+    int chooseNumLandmarks() const;
+
+    // Fills m_Distances from the cell, returning the longest distance
+    int runDijkstra(int sourceCell);
+    void quantize(int longestDistance);
+
+private:
+    static const std::int32_t UNREACHABLE_EXACT;
+    static const std::uint16_t UNREACHABLE_QUANTIZED;
+
+    const GridMap& m_Map;
+    const int m_RequestedLandmarks;
+    const LandmarkStorage m_Storage;
+    const std::size_t m_MemoryBudget;
+
+    int m_NumLandmarks;
+    std::vector<Point> m_Landmarks;
+    unsigned m_Revision;
+    bool m_IsBuilt;
+
+    // numCells * m_NumLandmarks entries, landmarks innermost so a lookup
+    // reads one run of memory per cell
+    std::vector<std::int32_t> m_ExactDistances;
+    std::vector<std::uint16_t> m_QuantizedDistances;
+
+    // Cost of one quantized unit
+    int m_Unit;
+    bool m_IsLossless;
+
+    // Scratch space for the Dijkstra searches
+    std::vector<int> m_Distances;
+    BinaryHeap<int> m_OpenSet;
+};
+
+// ALT: the largest bound any landmark gives, or the base heuristic's
+// estimate if that is larger or the table is out of date. The maximum of
+// admissible heuristics is admissible.
+template <typename BaseHeuristic>
+class LandmarkHeuristic
+{
+public:
+    typedef typename BaseHeuristic::Cost Cost;
+
+    static_assert(std::is_same<Cost, GridCost>::value, "Landmark distances are measured in GridCost steps");
+
+    explicit LandmarkHeuristic(const LandmarkTable& table, const BaseHeuristic& base = BaseHeuristic())
+        : m_Table(&table)
+        , m_Base(base)
+    {
+
+    }
+
+    int operator()(const Point& from, const Point& to) const
+    {
+        auto estimate = m_Base(from, to);
+        if (!m_Table->isCurrent())
+            return estimate;
+
+        return std::max(estimate, m_Table->getLowerBound(from, to));
+    }
+
+private:
+    const LandmarkTable* m_Table;
+    BaseHeuristic m_Base;
+};
+
+#endif
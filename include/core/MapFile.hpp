@@ -0,0 +1,42 @@
+#ifndef MAPFILE_HPP
+#define MAPFILE_HPP
+
+#include "core/GridMap.hpp"
+
+#include <cstddef>
+#include <string>
+
+// Binary map files: a small header with the map's size and movement
+// rules, then the walls exactly as GridMap keeps them, border and row
+// padding included. Numbers are stored in the machine's byte order.
+//
+// Loading maps the file into memory and points the GridMap straight at
+// the mapped walls, so nothing is parsed or copied and only the pages a
+// search touches are ever read. The mapping is private: editing the map
+// copies the pages it changes and never writes to the file.
+class MapFile
+{
+public:
+    MapFile();
+    ~MapFile();
+
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+
+    static bool save(const GridMap& map, const std::string& file);
+
+    // Whether the file starts like a map file, so callers can tell it
+    // from other formats without trusting its extension
+    static bool isMapFile(const std::string& file);
+
+    // The map views the mapped walls until it is resized, so it must not
+    // be used after this is closed or destroyed without resizing it first
+    bool load(const std::string& file, GridMap& map);
+    void close();
+
+private:
+    void* m_Data;
+    std::size_t m_Size;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef MAPGENERATOR_HPP
+#define MAPGENERATOR_HPP
+
+#include "core/GridMap.hpp"
+
+#include <cstdint>
+#include <random>
+
+// Makes seeded maps for benchmarks and tests: random obstacles, perfect
+// mazes and rooms joined by doors.
+//
+// The std distributions differ between standard libraries, but the
+// engine's own output does not, so everything is drawn from that and a
+// seed gives the same maps everywhere.
+class MapGenerator
+{
+public:
+    explicit MapGenerator(std::uint32_t seed);
+
+    // A number in [0, bound)
+    int getRandom(int bound);
+
+    // A free cell; the map must have one
+    Point getRandomCell(const GridMap& map);
+
+    // Each cell is a wall with a chance of density percent
+    void generateRandom(GridMap& map, int size, int density);
+
+    // A perfect maze carved by a depth-first walk, (size - 1) / 2 cells
+    // across so it expands to fit in size
+    void generateMaze(GridMap& map, int size);
+
+    // Square rooms separated by one cell thick walls, with a door of
+    // random width and place into each neighbouring room
+    void generateRooms(GridMap& map, int size, int roomSize = 16);
+
+private:
+    static const int MAX_DOOR_WIDTH;
+
+    std::mt19937 m_Random;
+};
+
+#endif
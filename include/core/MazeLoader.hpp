@@ -0,0 +1,29 @@
+#ifndef MAZELOADER_HPP
+#define MAZELOADER_HPP
+
+#include "core/GridMap.hpp"
+#include "core/MazeMap.hpp"
+
+#include <string>
+
+// Reads a maze file where every line is a row of cells and every cell is
+// a 4 character NESW string, '0' meaning that side has a wall.
+//
+// A MazeMap holds the maze as it is. A GridMap gets the maze expanded
+// by MazeMap::expand, so an n x n maze is loaded as a (2n + 1) x (2n + 1)
+// grid with extra rows and columns for the walls.
+class MazeLoader
+{
+public:
+    explicit MazeLoader(const std::string& file);
+
+    // False if the file cannot be read or its first line has no cells.
+    // Nothing is printed, so the caller reports the error.
+    bool load(MazeMap& maze) const;
+    bool load(GridMap& map) const;
+
+private:
+    std::string m_File;
+};
+
+#endif
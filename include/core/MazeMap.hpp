@@ -0,0 +1,67 @@
+#ifndef MAZEMAP_HPP
+#define MAZEMAP_HPP
+
+#include "core/GridMap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A maze stored as its cells and the four walls around each, instead of
+// a grid with a row and a column of wall cells between every two cells.
+//
+// Each cell keeps one bit per side, two cells to a byte. The wall
+// between two cells is kept in both of them, so a cell's moves can be
+// read from its own bits alone. The outer walls cannot be removed, so a
+// search never steps off the maze and cells need no border around them:
+// index = y * width + x.
+class MazeMap
+{
+public:
+    MazeMap();
+    MazeMap(int width, int height);
+
+    // Every side of every cell starts as a wall
+    void resize(int width, int height);
+
+    int getWidth() const;
+    int getHeight() const;
+    int getNumCells() const;
+
+    bool isInside(const Point& position) const;
+
+    // Only the four cardinal directions name a side
+    bool hasWall(int cell, Direction side) const;
+    bool hasWall(const Point& position, Direction side) const;
+    void addWall(const Point& position, Direction side);
+    void removeWall(const Point& position, Direction side);
+
+    int getCellIndex(const Point& position) const;
+    Point getCellPosition(int cell) const;
+    int getOffset(Direction side) const;
+
+    // The (2 * width + 1) x (2 * height + 1) grid the maze is drawn as,
+    // with every cell and every side getting a grid cell of its own. A
+    // corner post is a wall unless all four sides meeting at it are open.
+    void expand(GridMap& map) const;
+
+    // The grid cell a maze cell becomes, and a maze path as the grid
+    // path through the expanded map
+    static Point toGridPosition(const Point& position);
+    static void toGridPath(const std::vector<Point>& path, std::vector<Point>& gridPath);
+
+    std::size_t getMemoryUsage() const;
+
+private:
+    std::uint8_t getWalls(int cell) const;
+    void setWall(int cell, Direction side, bool isWall);
+
+private:
+    int m_Width;
+    int m_Height;
+
+    // Bit n of a cell's 4 bits is the side Direction 2 * n, so N, E, S, W
+    std::vector<std::uint8_t> m_Walls;
+};
+
+#endif
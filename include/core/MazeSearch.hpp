@@ -0,0 +1,33 @@
+#ifndef MAZESEARCH_HPP
+#define MAZESEARCH_HPP
+
+#include "core/BinaryHeap.hpp"
+#include "core/MazeMap.hpp"
+#include "core/Pathfinder.hpp"
+#include "core/SearchSpace.hpp"
+
+// A* over a MazeMap, reading each cell's moves from its wall bits.
+//
+// Positions and paths are in maze cells. A move costs what the two grid
+// steps it takes in the expanded map cost, so path costs can be compared
+// with searches of that map.
+class MazeSearch : public Pathfinder
+{
+public:
+    explicit MazeSearch(const MazeMap& maze);
+
+    bool findPath(const Point& start, const Point& goal) override;
+
+private:
+    void prepare();
+
+private:
+    const MazeMap& m_Maze;
+
+    // Numbered as the maze numbers its cells
+    SearchNodes m_Nodes;
+
+    BinaryHeap<SearchKey> m_OpenSet;
+};
+
+#endif
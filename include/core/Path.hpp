@@ -0,0 +1,59 @@
+#ifndef PATH_HPP
+#define PATH_HPP
+
+#include "core/GridMap.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// A path stored as its start cell plus one 3-bit Direction per step,
+// packed 21 steps to a 64-bit word. Only valid for paths where every
+// step moves to one of the 8 adjacent cells.
+class CompactPath
+{
+public:
+    CompactPath();
+
+    void encode(const std::vector<Point>& path);
+    void decode(std::vector<Point>& path) const;
+
+    bool isEmpty() const;
+    Point getStart() const;
+    int getNumSteps() const;
+    Direction getStep(int index) const;
+
+    // Bytes used by the packed steps
+    int getSizeInBytes() const;
+
+private:
+    static const int BITS_PER_STEP = 3;
+    static const int STEPS_PER_WORD = 64 / BITS_PER_STEP;
+
+    static Direction getDirection(const Point& from, const Point& to);
+
+private:
+    Point m_Start;
+    int m_NumSteps;
+    std::vector<std::uint64_t> m_Steps;
+};
+
+// Formats paths as "(x, y)->(x, y)..." into a reusable buffer and hands
+// the whole line to the stream in a single write
+class PathWriter
+{
+public:
+    explicit PathWriter(std::FILE* stream);
+
+    void write(const std::vector<Point>& path);
+
+private:
+    static char* append(char* cursor, const char* text, int length);
+    static char* appendNumber(char* cursor, int number);
+
+private:
+    std::FILE* m_Stream;
+    std::vector<char> m_Buffer;
+};
+
+#endif
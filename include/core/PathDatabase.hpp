@@ -0,0 +1,79 @@
+#ifndef PATHDATABASE_HPP
+#define PATHDATABASE_HPP
+
+#include "core/GridMap.hpp"
+#include "core/Pathfinder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compressed path database: for every free cell, the first move of an
+// optimal path to every other cell, so a query just follows first moves
+// from the start to the goal without searching.
+//
+// Free cells are numbered in depth-first order over the map's moves,
+// which keeps cells that are close on the map close in the numbering.
+// Seen from one source, targets that are close together tend to share a
+// first move, so each source's row of first moves is stored as runs over
+// that numbering. Where several first moves are optimal any of them will
+// do, and a run keeps going for as long as some move is optimal for every
+// target in it. A lookup is a binary search of one row.
+//
+// Building runs one Dijkstra search per free cell, spread over threads,
+// so it is only worth it for maps that do not change. The database
+// answers queries only while the map is at the revision it was built or
+// loaded for.
+class PathDatabase : public Pathfinder
+{
+public:
+    explicit PathDatabase(const GridMap& map);
+
+    // Uses one thread per core if numThreads is 0
+    void build(int numThreads = 0);
+
+    // The file records the map's size, rules and walls, and load fails
+    // unless they match the map as it is now. It also fails on a file
+    // whose size, row offsets or runs do not add up. Numbers are stored
+    // in the machine's byte order.
+    bool save(const std::string& file) const;
+    bool load(const std::string& file);
+
+    bool isCurrent() const;
+
+    // Each first move followed counts as one expansion
+    bool findPath(const Point& start, const Point& goal) override;
+
+    std::size_t getNumRuns() const;
+    std::size_t getMemoryUsage() const;
+
+private:
+    void buildOrdering();
+    void buildRows(std::vector<std::vector<std::uint32_t>>& rows, int numThreads);
+    std::uint32_t getMapChecksum() const;
+
+    Direction getFirstMove(int sourceCell, int targetCell) const;
+
+private:
+    const GridMap& m_Map;
+
+    // Free cells in depth-first order, and the place of each cell in it
+    // (-1 for walls)
+    std::vector<int> m_Cells;
+    std::vector<int> m_Orders;
+
+    // Region of each cell, so queries between regions fail straight away
+    std::vector<int> m_Regions;
+
+    // The runs of source i are m_Runs[m_RowOffsets[i]] up to
+    // m_RowOffsets[i + 1]. Each packs the place of its first target in
+    // the ordering above a 3 bit Direction.
+    std::vector<std::uint64_t> m_RowOffsets;
+    std::vector<std::uint32_t> m_Runs;
+
+    unsigned m_Revision;
+    bool m_IsBuilt;
+};
+
+#endif
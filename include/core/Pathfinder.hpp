@@ -0,0 +1,51 @@
+#ifndef PATHFINDER_HPP
+#define PATHFINDER_HPP
+
+#include "core/Point.hpp"
+
+#include <vector>
+
+// Common interface of the search engines. Each engine keeps its own
+// buffers between queries, so reuse one instance for many searches.
+class Pathfinder
+{
+public:
+    Pathfinder()
+        : m_PathCost(0)
+        , m_NumExpansions(0)
+    {
+
+    }
+
+    virtual ~Pathfinder()
+    {
+
+    }
+
+    // False if there is no path, which includes a start or goal on a wall
+    virtual bool findPath(const Point& start, const Point& goal) = 0;
+
+    // The path found by the last search, from the start to the goal. The
+    // buffer is reused by the next search.
+    const std::vector<Point>& getPath() const
+    {
+        return m_Path;
+    }
+
+    int getPathCost() const
+    {
+        return m_PathCost;
+    }
+
+    int getNumExpansions() const
+    {
+        return m_NumExpansions;
+    }
+
+protected:
+    std::vector<Point> m_Path;
+    int m_PathCost;
+    int m_NumExpansions;
+};
+
+#endif
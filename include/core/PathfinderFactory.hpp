@@ -0,0 +1,72 @@
+#ifndef PATHFINDERFACTORY_HPP
+#define PATHFINDERFACTORY_HPP
+
+#include "core/GridMap.hpp"
+#include "core/Heuristics.hpp"
+#include "core/LandmarkTable.hpp"
+#include "core/Pathfinder.hpp"
+
+#include <memory>
+#include <string>
+
+enum class SearchAlgorithm
+{
+    AStar,
+    JumpPoint,
+    JumpPointPlus,
+    Bidirectional,
+    Incremental,
+    Hierarchical,
+    Corridors
+};
+
+enum class OpenListType
+{
+    BinaryHeap,
+    Buckets
+};
+
+// Picks a template instantiation for options only known at run time
+class PathfinderFactory
+{
+public:
+    // The algorithm with its default options for the map
+    static std::unique_ptr<Pathfinder> create(const GridMap& map, SearchAlgorithm algorithm);
+
+    static std::unique_ptr<Pathfinder> createAStar(const GridMap& map, HeuristicType heuristic,
+                                                   double epsilon = 0.0,
+                                                   OpenListType openList = OpenListType::BinaryHeap,
+                                                   StepCosts costs = StepCosts::Grid);
+
+    // A* with the ALT heuristic, falling back to the default heuristic
+    // wherever that is larger or the table is out of date
+    static std::unique_ptr<Pathfinder> createLandmarkAStar(const GridMap& map, const LandmarkTable& landmarks);
+
+    static std::unique_ptr<Pathfinder> createBidirectional(const GridMap& map, HeuristicType heuristic,
+                                                           StepCosts costs = StepCosts::Grid);
+
+    // Jump Point Search, or JPS+ with precomputed jumps. Falls back to A*
+    // with the default heuristic on maps JPS does not support.
+    static std::unique_ptr<Pathfinder> createJumpPointSearch(const GridMap& map, bool usePrecomputedJumps = false);
+
+    // Manhattan on 4-connected maps, octile on 8-connected ones
+    static HeuristicType getDefaultHeuristic(const GridMap& map);
+
+    // The short names the command line tools take: astar, jps, jps+,
+    // bidirectional, dstar, hpa and corridors
+    static bool findAlgorithm(const std::string& name, SearchAlgorithm& algorithm);
+    static const char* getAlgorithmName(SearchAlgorithm algorithm);
+
+private:
+    template <typename Cost>
+    static std::unique_ptr<Pathfinder> createAStarFor(const GridMap& map, HeuristicType heuristic,
+                                                      double epsilon, OpenListType openList);
+
+    template <typename Heuristic>
+    static std::unique_ptr<Pathfinder> createAStarWith(const GridMap& map, double epsilon, OpenListType openList);
+
+    template <typename Cost>
+    static std::unique_ptr<Pathfinder> createBidirectionalFor(const GridMap& map, HeuristicType heuristic);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SCENARIOLOADER_HPP
+#define SCENARIOLOADER_HPP
+
+#include "core/Point.hpp"
+
+#include <string>
+#include <vector>
+
+// One query of a benchmark scenario. The optimal length counts straight
+// steps as 1 and diagonal steps as sqrt(2).
+struct ScenarioQuery
+{
+    int bucket;
+    std::string map;
+    int mapWidth;
+    int mapHeight;
+    Point start;
+    Point goal;
+    double optimalLength;
+};
+
+// Reads a scenario in the MovingAI benchmark .scen format: a version
+// line, then one query per line with its bucket, map file, map size,
+// start, goal and optimal length
+class ScenarioLoader
+{
+public:
+    explicit ScenarioLoader(const std::string& file);
+
+    bool load(std::vector<ScenarioQuery>& queries) const;
+
+private:
+    std::string m_File;
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef SEARCHSPACE_HPP
+#define SEARCHSPACE_HPP
+
+#include "core/GridMap.hpp"
+
+#include <cstdint>
+#include <vector>
+
+enum class CellState : unsigned char
+{
+    Unvisited,
+    Open,
+    Closed,
+    Blocked
+};
+
+// Per-cell search state, stored in one row-major array indexed by cell.
+// The score lives in the open set's heap entries, so a node only needs
+// its movement cost and parent: 12 bytes per cell.
+//
+// A node only belongs to the current search if its stamp matches the
+// current generation (open) or the one after it (closed). Anything older
+// is unvisited, so nothing has to be cleared between searches.
+struct SearchNode
+{
+    int movementCost;
+    int parent;
+    std::uint32_t stamp;
+};
+
+static_assert(sizeof(SearchNode) == 12, "SearchNode should stay packed to 12 bytes");
+
+// The stamped nodes behind SearchSpace, for engines that number their
+// cells some other way than a GridMap does
+class SearchNodes
+{
+public:
+    SearchNodes();
+
+    // Starts a new search over numCells nodes. O(1) unless the number of
+    // cells has changed.
+    void prepare(int numCells);
+
+    SearchNode& getNode(int cell)
+    {
+        return m_Nodes[cell];
+    }
+
+    const SearchNode& getNode(int cell) const
+    {
+        return m_Nodes[cell];
+    }
+
+    bool isOpen(int cell) const
+    {
+        return m_Nodes[cell].stamp == m_Generation;
+    }
+
+    bool isClosed(int cell) const
+    {
+        return m_Nodes[cell].stamp == m_Generation + 1;
+    }
+
+    // Open or Closed; unvisited nodes are just never stamped
+    void setState(int cell, CellState state)
+    {
+        m_Nodes[cell].stamp = m_Generation + (state == CellState::Closed ? 1 : 0);
+    }
+
+    // Follows parents back from cell, writing the positions the map gives
+    // the cells, start first
+    template <typename Map>
+    void buildPath(const Map& map, int cell, std::vector<Point>& path) const
+    {
+        // Count the steps first so the path can be filled in back to front
+        // and come out in forward order without a reverse
+        int length = 0;
+        for (auto current = cell; current != -1; current = m_Nodes[current].parent)
+            ++length;
+
+        path.resize(length);
+        for (auto current = cell; current != -1; current = m_Nodes[current].parent)
+            path[--length] = map.getCellPosition(current);
+    }
+
+private:
+    std::vector<SearchNode> m_Nodes;
+    std::uint32_t m_Generation;
+};
+
+// The search nodes of one map, shared by the engines that search it cell
+// by cell
+class SearchSpace
+{
+public:
+    explicit SearchSpace(const GridMap& map);
+
+    // Starts a new search. O(1) unless the map has been resized.
+    void prepare();
+
+    SearchNode& getNode(int cell);
+    const SearchNode& getNode(int cell) const;
+
+    CellState getState(int cell) const;
+    void setState(int cell, CellState state);
+
+    // Follows parents back from cell, writing the cells start first
+    void buildPath(int cell, std::vector<Point>& path) const;
+
+private:
+    const GridMap& m_Map;
+
+    SearchNodes m_Nodes;
+};
+
+#endif
@@ -1,13 +1,29 @@
 solution "AStar"
 	configurations { "Debug", "Release" }
 	location "build/"
+
+	-- Grid, search engines and map loaders. Has no SFML dependency so it
+	-- can be used headless.
+	project "AStarCore"
+		kind "StaticLib"
+		language "C++"
+		files { "src/core/*.cpp" }
+		includedirs { "include" }
+		location "build/"
+		buildoptions "-std=c++11 -pthread"
+
+		configuration "Debug"
+			flags { "ExtraWarnings" }
+
+		configuration "Release"
+			flags { "Optimize" }
 	
 	project "AStar"
 		kind "ConsoleApp"
 		language "C++"
 		files { "src/*.cpp" }
 		includedirs { "include" }
-		links { "sfml-graphics", "sfml-window", "sfml-system", "jpeg", "GLEW" }
+		links { "AStarCore", "sfml-graphics", "sfml-window", "sfml-system", "jpeg", "GLEW", "pthread" }
 		location "build/"
 		buildoptions "-std=c++11 -Wno-narrowing"
 
@@ -16,3 +32,83 @@ solution "AStar"
 
 		configuration "Release"
 			flags { "Optimize" }
+
+	-- Converts text mazes and MovingAI maps into binary map files
+	project "MapConverter"
+		kind "ConsoleApp"
+		language "C++"
+		files { "tools/MapConverter.cpp" }
+		includedirs { "include" }
+		links { "AStarCore" }
+		location "build/"
+		buildoptions "-std=c++11"
+
+		configuration "Debug"
+			flags { "ExtraWarnings" }
+
+		configuration "Release"
+			flags { "Optimize" }
+
+	-- Runs MovingAI scenarios headless and reports per-bucket stats
+	project "ScenarioRunner"
+		kind "ConsoleApp"
+		language "C++"
+		files { "tools/ScenarioRunner.cpp" }
+		includedirs { "include" }
+		links { "AStarCore" }
+		location "build/"
+		buildoptions "-std=c++11"
+
+		configuration "Debug"
+			flags { "ExtraWarnings" }
+
+		configuration "Release"
+			flags { "Optimize" }
+
+	-- Times a search engine on seeded generated maps, "make bench"
+	project "bench"
+		kind "ConsoleApp"
+		language "C++"
+		files { "tools/Benchmark.cpp" }
+		includedirs { "include" }
+		links { "AStarCore" }
+		location "build/"
+		buildoptions "-std=c++11"
+
+		configuration "Debug"
+			flags { "ExtraWarnings" }
+
+		configuration "Release"
+			flags { "Optimize" }
+
+	-- Checks that searches allocate nothing once their buffers are sized
+	project "AllocationTest"
+		kind "ConsoleApp"
+		language "C++"
+		files { "tests/AllocationTest.cpp" }
+		includedirs { "include" }
+		links { "AStarCore" }
+		location "build/"
+		buildoptions "-std=c++11"
+
+		configuration "Debug"
+			flags { "ExtraWarnings" }
+
+		configuration "Release"
+			flags { "Optimize" }
+
+	-- Checks the optimal searches against a plain Dijkstra
+	project "OptimalityTest"
+		kind "ConsoleApp"
+		language "C++"
+		files { "tests/OptimalityTest.cpp" }
+		includedirs { "include" }
+		links { "AStarCore" }
+		location "build/"
+		buildoptions "-std=c++11"
+
+		configuration "Debug"
+			flags { "ExtraWarnings" }
+
+		configuration "Release"
+			flags { "Optimize" }
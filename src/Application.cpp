@@ -1,5 +1,7 @@
 #include "Application.hpp"
 
+#include <cstdio>
+
 Application::Application(int width, int height, int numNodes)
     : m_Width(width)
     , m_Height(height)
@@ -74,8 +76,10 @@ void Application::handleMousePress(const sf::Event& event)
     auto gridX = event.mouseButton.x / m_Grid.getNodeSize().x;
     auto gridY = event.mouseButton.y / m_Grid.getNodeSize().y;
 
-    // If the position of the click is out of bounds, just return
-    if (gridX < 0 || gridX >= m_Grid.getNumNodes() || gridY < 0 || gridY >= m_Grid.getNumNodes())
+    // If the position of the click is out of bounds, just return. Loaded
+    // maps need not be square, so each axis has its own bound.
+    auto numNodes = m_Grid.getNumNodes();
+    if (gridX < 0 || gridX >= numNodes.x || gridY < 0 || gridY >= numNodes.y)
         return;
 
     if (event.mouseButton.button == sf::Mouse::Left)
@@ -117,6 +121,26 @@ void Application::handleKeyPress(const sf::Event& event)
     {
         reset();
     }
+    else if (event.key.code == sf::Keyboard::D)
+    {
+        toggleDiagonalMovement();
+    }
+    else if (event.key.code == sf::Keyboard::C)
+    {
+        cycleCornerCutting();
+    }
+    else if (event.key.code == sf::Keyboard::A)
+    {
+        cycleAlgorithm();
+    }
+    else if (event.key.code == sf::Keyboard::P)
+    {
+        togglePruning();
+    }
+    else if (event.key.code == sf::Keyboard::N)
+    {
+        toggleNativeMaze();
+    }
 }
 
 void Application::beginSearch()
@@ -133,3 +157,83 @@ void Application::reset()
 
     m_Grid.reset();
 }
+
+void Application::toggleDiagonalMovement()
+{
+    if (m_Grid.getConnectivity() == Connectivity::Four)
+    {
+        m_Grid.setConnectivity(Connectivity::Eight);
+        std::printf("Diagonal movement on\n");
+    }
+    else
+    {
+        m_Grid.setConnectivity(Connectivity::Four);
+        std::printf("Diagonal movement off\n");
+    }
+}
+
+void Application::cycleCornerCutting()
+{
+    switch (m_Grid.getCornerCutting())
+    {
+        case CornerCutting::Allow:
+            m_Grid.setCornerCutting(CornerCutting::NoSqueeze);
+            std::printf("Corner cutting: no squeezing between walls\n");
+            break;
+        case CornerCutting::NoSqueeze:
+            m_Grid.setCornerCutting(CornerCutting::Never);
+            std::printf("Corner cutting: never\n");
+            break;
+        case CornerCutting::Never:
+            m_Grid.setCornerCutting(CornerCutting::Allow);
+            std::printf("Corner cutting: allowed\n");
+            break;
+    }
+}
+
+void Application::cycleAlgorithm()
+{
+    switch (m_Grid.getAlgorithm())
+    {
+        case SearchAlgorithm::AStar:
+            m_Grid.setAlgorithm(SearchAlgorithm::JumpPoint);
+            std::printf("Algorithm: Jump Point Search\n");
+            break;
+        case SearchAlgorithm::JumpPoint:
+            m_Grid.setAlgorithm(SearchAlgorithm::JumpPointPlus);
+            std::printf("Algorithm: JPS+\n");
+            break;
+        case SearchAlgorithm::JumpPointPlus:
+            m_Grid.setAlgorithm(SearchAlgorithm::Bidirectional);
+            std::printf("Algorithm: bidirectional A*\n");
+            break;
+        case SearchAlgorithm::Bidirectional:
+            m_Grid.setAlgorithm(SearchAlgorithm::Incremental);
+            std::printf("Algorithm: D* Lite, replanning after wall edits\n");
+            break;
+        case SearchAlgorithm::Incremental:
+            m_Grid.setAlgorithm(SearchAlgorithm::Hierarchical);
+            std::printf("Algorithm: HPA*, near-optimal\n");
+            break;
+        case SearchAlgorithm::Hierarchical:
+            m_Grid.setAlgorithm(SearchAlgorithm::Corridors);
+            std::printf("Algorithm: A* over contracted corridors\n");
+            break;
+        case SearchAlgorithm::Corridors:
+            m_Grid.setAlgorithm(SearchAlgorithm::AStar);
+            std::printf("Algorithm: A*\n");
+            break;
+    }
+}
+
+void Application::togglePruning()
+{
+    m_Grid.setPruning(!m_Grid.isPruning());
+    std::printf("Dead-end pruning %s\n", m_Grid.isPruning() ? "on" : "off");
+}
+
+void Application::toggleNativeMaze()
+{
+    m_Grid.setNativeMaze(!m_Grid.isNativeMaze());
+    std::printf("Native maze search %s\n", m_Grid.isNativeMaze() ? "on" : "off");
+}
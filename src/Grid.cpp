@@ -1,45 +1,70 @@
 #include "Grid.hpp"
 
-#include <cassert>
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include "core/DeadEndPruning.hpp"
+
+#include <cstdio>
+#include <stdexcept>
 
 Grid::Grid(int numNodes, const sf::Vector2i& gridSize)
-    : m_NumNodes(numNodes)
-    , GRID_SIZE(gridSize)
-    , HORIZONTAL_COST(10)
-    , VERTICAL_COST(10)
-    , DIAGONAL_COST(14)
-    , m_Nodes(m_NumNodes, std::vector<Node>(m_NumNodes, Node({ -1, -1 }, { 0, 0 })))
+    : GRID_SIZE(gridSize)
+    , m_Map(numNodes, numNodes)
+    , m_Components(m_Map)
+    , m_MazeRevision(0)
+    , m_IsNativeMaze(false)
+    , m_Algorithm(SearchAlgorithm::AStar)
+    , m_IsPruning(false)
+    , m_Nodes(numNodes * numNodes, Node({ -1, -1 }, { 0, 0 }))
     , m_StartPosition(-1, -1)
     , m_EndPosition(-1, -1)
     , m_HasFoundPath(false)
+    , m_PathWriter(stdout)
     , m_IsMaze(false)
 {
+    createSearch();
     createNodes();
     createLines();
 }
 
 Grid::Grid(const std::string& file, const sf::Vector2i& gridSize)
     : GRID_SIZE(gridSize)
-    , HORIZONTAL_COST(10)
-    , VERTICAL_COST(10)
-    , DIAGONAL_COST(14)
+    , m_Components(m_Map)
+    , m_MazeRevision(0)
+    , m_IsNativeMaze(true)
+    , m_Algorithm(SearchAlgorithm::AStar)
+    , m_IsPruning(true)
     , m_StartPosition(-1, -1)
     , m_EndPosition(-1, -1)
     , m_HasFoundPath(false)
+    , m_PathWriter(stdout)
     , m_IsMaze(true)
 {
-    // Multiply by 2 and add 1 because we need
-    // extra columns and rows for the walls
-    m_NumNodes = parseNumNodes(file) * 2 + 1;
-    m_Nodes = std::vector<std::vector<Node>>(m_NumNodes, std::vector<Node>(m_NumNodes, Node({ -1, -1 }, { 0, 0 })));
+    // Binary map files are used as they are, with no maze to search.
+    // A file that fails to load, or holds an empty map, would leave no
+    // nodes to size or draw, so it stops construction.
+    if (MapFile::isMapFile(file))
+    {
+        if (!m_MapFile.load(file, m_Map) || (m_Map.getWidth() == 0) || (m_Map.getHeight() == 0))
+            throw std::runtime_error("Error loading map file " + file);
+    }
+    else
+    {
+        if (!MazeLoader(file).load(m_Maze))
+            throw std::runtime_error("Error parsing maze file " + file);
 
+        m_Maze.expand(m_Map);
+        m_MazeRevision = m_Map.getRevision();
+        m_MazeSearch.reset(new MazeSearch(m_Maze));
+    }
+
+    m_Components.update();
+
+    // Maps need not be square, so the nodes are laid out by both sides
+    m_Nodes.assign(m_Map.getWidth() * m_Map.getHeight(), Node({ -1, -1 }, { 0, 0 }));
+
+    createSearch();
     createNodes();
     createLines();
-
-    parseNodes(file);
+    colorWalls();
 }
 
 void Grid::draw(sf::RenderTarget& target, sf::RenderStates states) const
@@ -50,10 +75,10 @@ void Grid::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
 bool Grid::setStartPosition(const sf::Vector2i& position)
 {
-    if (std::find(m_Walls.begin(), m_Walls.end(), position) == m_Walls.end())
+    if (!m_Map.isWall(toPoint(position)))
     {
         m_StartPosition = position;
-        m_Nodes[position.x][position.y].setColor(sf::Color::Green);
+        m_Nodes[getNodeIndex(position)].setColor(sf::Color::Green);
         return true;
     }
 
@@ -62,10 +87,10 @@ bool Grid::setStartPosition(const sf::Vector2i& position)
 
 bool Grid::setEndPosition(const sf::Vector2i& position)
 {
-    if (std::find(m_Walls.begin(), m_Walls.end(), position) == m_Walls.end())
+    if (!m_Map.isWall(toPoint(position)))
     {
         m_EndPosition = position;
-        m_Nodes[position.x][position.y].setColor(sf::Color::Red);
+        m_Nodes[getNodeIndex(position)].setColor(sf::Color::Red);
         return true;
     }
 
@@ -74,21 +99,19 @@ bool Grid::setEndPosition(const sf::Vector2i& position)
 
 void Grid::addWall(const sf::Vector2i& position)
 {
-    if (std::find(m_Walls.begin(), m_Walls.end(), position) == m_Walls.end()
-     && std::find(m_Walls.begin(), m_Walls.end(), m_StartPosition) == m_Walls.end()
-     && std::find(m_Walls.begin(), m_Walls.end(), m_EndPosition) == m_Walls.end())
+    if (!m_Map.isWall(toPoint(position)) && (position != m_StartPosition) && (position != m_EndPosition))
     {
-        m_Walls.push_back(position);
-        m_Nodes[position.x][position.y].setColor(sf::Color::Black);
+        m_Map.addWall(toPoint(position));
+        m_Nodes[getNodeIndex(position)].setColor(sf::Color::Black);
     }
 }
 
 void Grid::removeWall(const sf::Vector2i& position)
 {
-    if (std::find(m_Walls.begin(), m_Walls.end(), position) != m_Walls.end())
+    if (m_Map.isWall(toPoint(position)))
     {
-        m_Walls.erase(std::find(m_Walls.begin(), m_Walls.end(), position));
-        m_Nodes[position.x][position.y].setColor(sf::Color::White);
+        m_Map.removeWall(toPoint(position));
+        m_Nodes[getNodeIndex(position)].setColor(sf::Color::White);
     }
 }
 
@@ -99,531 +122,249 @@ sf::Vector2i Grid::getGridSize() const
 
 sf::Vector2i Grid::getNodeSize() const
 {
-    return { GRID_SIZE.x / m_NumNodes, GRID_SIZE.y / m_NumNodes };
+    return { GRID_SIZE.x / m_Map.getWidth(), GRID_SIZE.y / m_Map.getHeight() };
 }
 
-int Grid::getNumNodes() const
+sf::Vector2i Grid::getNumNodes() const
 {
-    return m_NumNodes;
+    return { m_Map.getWidth(), m_Map.getHeight() };
 }
 
-void Grid::reset()
+void Grid::setConnectivity(Connectivity connectivity)
 {
-    if (m_IsMaze)
-    {
-        colorPath(sf::Color::White);
-        m_Nodes[m_StartPosition.x][m_StartPosition.y].setColor(sf::Color::White);
-        m_Nodes[m_EndPosition.x][m_EndPosition.y].setColor(sf::Color::White);
-    }
-    else
-        createNodes();
-
-    m_Path.clear();
-    m_HasFoundPath = false;
-}
-
-void Grid::beginSearch()
-{
-    std::vector<sf::Vector2i> closedSet = m_Walls;
-    std::vector<sf::Vector2i> openSet = { m_StartPosition };
-
-    auto& startNode = m_Nodes[m_StartPosition.x][m_StartPosition.y];
-    startNode.setMovementCost(0);
-    startNode.setHeuristicCost(calculateHeuristicCost(m_StartPosition, m_EndPosition));
-    startNode.setScore(startNode.getMovementCost() + startNode.getHeuristicCost());
-
-    while (!openSet.empty())
-    {
-        auto currentNodePosition = getLowestScoredNode(openSet);
-        if (currentNodePosition == m_EndPosition)
-        {
-            std::printf("Found path: ");
-            m_HasFoundPath = true;
-            buildPath(m_EndPosition);
-            printPath();
-            colorPath();
-            break;
-        }
-
-        openSet.erase(std::find(openSet.begin(), openSet.end(), currentNodePosition));
-        closedSet.push_back(currentNodePosition);
-
-        for (auto& neighborPosition : getNeighborNodes(currentNodePosition))
-        {
-            if (std::find(closedSet.begin(), closedSet.end(), neighborPosition) != closedSet.end())
-                continue;
-
-            auto& currentNode = m_Nodes[currentNodePosition.x][currentNodePosition.y];
-            auto tentativeMovementCost = currentNode.getMovementCost()
-                                       + calculateMovementCost(currentNodePosition, neighborPosition);
-
-            bool neighborInOpenSet = (std::find(openSet.begin(), openSet.end(), neighborPosition) != openSet.end());
-            auto& neighborNode = m_Nodes[neighborPosition.x][neighborPosition.y];
-            if (!neighborInOpenSet || (tentativeMovementCost < neighborNode.getMovementCost()))
-            {
-                neighborNode.setParentPosition(currentNodePosition);
-                neighborNode.setMovementCost(tentativeMovementCost);
-                neighborNode.setScore(neighborNode.getMovementCost()
-                                    + calculateHeuristicCost(neighborPosition, m_EndPosition));
-
-                if (!neighborInOpenSet)
-                    openSet.push_back(neighborPosition);
-            }
-        }
-    }
-
-    if (!m_HasFoundPath)
-        std::printf("Found no path :(\n");
+    m_Map.setConnectivity(connectivity);
+    createSearch();
 }
 
-void Grid::createNodes()
+Connectivity Grid::getConnectivity() const
 {
-    for (int x = 0; x < m_NumNodes; ++x)
-    {
-        for (int y = 0; y < m_NumNodes; ++y)
-        {
-            sf::Vector2i position(x, y);
-            sf::Vector2i size(GRID_SIZE.x / m_NumNodes, GRID_SIZE.y / m_NumNodes);
-
-            Node node(position, size);
-            m_Nodes[x][y] = node;
-        }
-    }
+    return m_Map.getConnectivity();
 }
 
-void Grid::createLines()
+void Grid::setCornerCutting(CornerCutting cornerCutting)
 {
-    for (int x = 0; x < m_NumNodes; ++x)
-    {
-        for (int y = 0; y < m_NumNodes; ++y)
-        {
-            sf::RectangleShape shape;
-            shape.setFillColor(sf::Color::Black);
-            shape.setPosition(x * (GRID_SIZE.x / m_NumNodes), y * (GRID_SIZE.y / m_NumNodes));
-
-            // Horizontal line
-            shape.setSize({ GRID_SIZE.x, 1.f });
-            m_Lines.push_back(shape);
-
-            // Vertical line
-            shape.setSize({ 1.f, GRID_SIZE.y });
-            m_Lines.push_back(shape);
-        }
-    }
+    m_Map.setCornerCutting(cornerCutting);
+    createSearch();
 }
 
-void Grid::parseNodes(const std::string& file)
+CornerCutting Grid::getCornerCutting() const
 {
-    auto nodeStrings = extractNodes(file);
-
-    // Add initial walls
-    for (int i = 0; i < m_NumNodes; ++i)
-    {
-        addWall({ i, 0 });
-        addWall({ 0, i });
-        addWall({ i, m_NumNodes - 1 });
-        addWall({ m_NumNodes - 1, i });
-    }
-
-    for (unsigned x = 0; x < nodeStrings.size(); ++x)
-    {
-        for (unsigned y = 0; y < nodeStrings[x].size(); ++y)
-        {
-            bool hasNorthWall = (nodeStrings[y][x][0] == '0');
-            bool hasEastWall = (nodeStrings[y][x][1] == '0');
-            bool hasSouthWall = (nodeStrings[y][x][2] == '0');
-            bool hasWestWall = (nodeStrings[y][x][3] == '0');
-
-            auto cellX = x * 2 + 1;
-            auto cellY = y * 2 + 1;
-
-            sf::Vector2i north = { cellX, cellY - 1 },
-                         northeast = { cellX + 1, cellY - 1 }, 
-                         east = { cellX + 1, cellY },
-                         southeast = { cellX + 1, cellY + 1 },
-                         south = { cellX, cellY + 1 },
-                         southwest = { cellX - 1, cellY + 1 },
-                         west = { cellX - 1, cellY },
-                         northwest = { cellX - 1, cellY - 1 };
-            
-            if ((hasNorthWall && hasEastWall) || (hasEastWall && hasNorthWall))
-            {
-                addWall(north); addWall(northeast); addWall(east);
-            }
-            if ((hasNorthWall && hasWestWall) || (hasWestWall && hasNorthWall))
-            {
-                addWall(north); addWall(northwest); addWall(west);
-            }
-            if ((hasSouthWall && hasEastWall) || (hasEastWall && hasSouthWall))
-            {
-                addWall(south); addWall(southeast); addWall(east);
-            }
-            if ((hasSouthWall && hasWestWall) || (hasWestWall && hasSouthWall))
-            {  
-                addWall(south); addWall(southwest); addWall(west);
-            }
-            if (hasNorthWall)
-            {
-                addWall(north);
-
-                if ((x != 0) && (x != nodeStrings.size() - 1))
-                {
-                    // If the cell to the left/right also has a north
-                    // wall, add a wall inbetween the two cells
-                    if (nodeStrings[y][x-1][0] == '0')
-                        addWall({ cellX - 1, cellY - 1 });
-                    if (nodeStrings[y][x+1][0] == '0')
-                        addWall({ cellX + 1, cellY - 1 });
-                }
-            }
-            if (hasEastWall)
-            {
-                addWall(east);
-
-                if ((y != 0) && (y != nodeStrings.size() - 1))
-                {
-                    // If the cell above/below also has a east
-                    // wall, add a wall inbetween the two cells
-                    if (nodeStrings[y-1][x][1] == '0')
-                        addWall({ cellX + 1, cellY - 1 });
-                    if (nodeStrings[y+1][x][2] == '0')
-                        addWall({ cellX + 1, cellY + 1 });
-                }
-            }
-            if (hasSouthWall)
-            {
-                addWall(south);
-
-                if ((x != 0) && (x != nodeStrings.size() - 1))
-                {
-                    // If the cell to the left/right also has a south
-                    // wall, add a wall inbetween the two cells
-                    if (nodeStrings[y][x-1][2] == '0')
-                        addWall({ cellX - 1, cellY + 1 });
-                    if (nodeStrings[y][x+1][2] == '0')
-                        addWall({ cellX + 1, cellY + 1 });
-                }
-
-            }
-            if (hasWestWall)
-            {
-                addWall(west);
-
-                if ((y != 0) && (y != nodeStrings.size() - 1))
-                {
-                    // If the cell above/below also has a west
-                    // wall, add a wall inbetween the two cells
-                    if (nodeStrings[y-1][x][3] == '0')
-                        addWall({ cellX - 1, cellY - 1 });
-                    if (nodeStrings[y+1][x][3] == '0')
-                        addWall({ cellX - 1, cellY + 1 });
-                }
-            }
-        }
-    }
+    return m_Map.getCornerCutting();
 }
 
-std::vector<std::vector<std::string>> Grid::extractNodes(const std::string& file)
+void Grid::setAlgorithm(SearchAlgorithm algorithm)
 {
-    std::vector<std::vector<std::string>> nodeStrings;
-
-    std::ifstream inputFile(file);
-    std::string line;
-    while (std::getline(inputFile, line))
-    {
-        std::vector<std::string> row;
-
-        std::stringstream strStream(line);
-        std::string node;
-        while (std::getline(strStream, node, ' '))
-        {
-            row.push_back(node);
-        }
-
-        nodeStrings.push_back(row);
-    }
-
-    return nodeStrings;
+    m_Algorithm = algorithm;
+    createSearch();
 }
 
-int Grid::parseNumNodes(const std::string& file) const
+SearchAlgorithm Grid::getAlgorithm() const
 {
-    int numNodes = 0;
-
-    std::ifstream inputFile(file);
-    
-    std::string line;
-    if (std::getline(inputFile, line))
-    {
-        std::stringstream strStream(line);
-        std::string node;
-        while (std::getline(strStream, node, ' '))
-            ++numNodes;
-    }
-    else
-    {
-        std::cerr << "Error parsing file, it has no lines!" << std::endl;
-    }
-    
-    std::printf("Num nodes = %i\n", numNodes);
-
-    return numNodes;
+    return m_Algorithm;
 }
 
-void Grid::drawNodes(sf::RenderTarget& target, sf::RenderStates states) const
+void Grid::setPruning(bool isPruning)
 {
-    for (int x = 0; x < m_NumNodes; ++x)
-    {
-        for (int y = 0; y < m_NumNodes; ++y)
-        {
-            target.draw(m_Nodes[x][y]);
-        }
-    }
+    m_IsPruning = isPruning;
+    createSearch();
 }
 
-void Grid::drawLines(sf::RenderTarget& target, sf::RenderStates states) const
+bool Grid::isPruning() const
 {
-    for (auto& line : m_Lines)
-        target.draw(line);
+    return m_IsPruning;
 }
 
-int Grid::calculateHeuristicCost(const sf::Vector2i& from, const sf::Vector2i& to) const
+void Grid::setNativeMaze(bool isNativeMaze)
 {
-    auto deltaX = std::abs(to.x - from.x);
-    auto deltaY = std::abs(to.y - from.y);
-    auto heuristicCost = std::ceil((deltaX + deltaY));
-
-    return heuristicCost;
+    m_IsNativeMaze = isNativeMaze;
 }
 
-int Grid::calculateMovementCost(const sf::Vector2i& from, const sf::Vector2i& to) const
+bool Grid::isNativeMaze() const
 {
-    auto deltaX = std::abs(to.x - from.x);
-    auto deltaY = std::abs(to.y - from.y);
-
-    return HORIZONTAL_COST * deltaX + VERTICAL_COST * deltaY;
+    return m_IsNativeMaze;
 }
 
-sf::Vector2i Grid::getLowestScoredNode(const std::vector<sf::Vector2i>& nodes) const
+void Grid::reset()
 {
-    assert(nodes.size() > 0);
+    // Only repaint the cells that changed, the search itself needs no reset
+    colorPath(sf::Color::White);
 
-    sf::Vector2i lowest = nodes[0];
+    if (m_Map.isInside(toPoint(m_StartPosition)))
+        m_Nodes[getNodeIndex(m_StartPosition)].setColor(sf::Color::White);
+    if (m_Map.isInside(toPoint(m_EndPosition)))
+        m_Nodes[getNodeIndex(m_EndPosition)].setColor(sf::Color::White);
 
-    for (auto& node : nodes)
+    // Free-draw grids start over without any walls
+    if (!m_IsMaze)
     {
-        if (m_Nodes[node.x][node.y].getScore() < m_Nodes[lowest.x][lowest.y].getScore())
-            lowest = node;
+        colorWalls(sf::Color::White);
+        m_Map.clearWalls();
     }
 
-    return lowest;
+    m_StartPosition = { -1, -1 };
+    m_EndPosition = { -1, -1 };
+
+    m_Path.clear();
+    m_HasFoundPath = false;
 }
 
-std::vector<sf::Vector2i> Grid::getNeighborNodes(const sf::Vector2i& node) const
+void Grid::beginSearch()
 {
-    std::vector<sf::Vector2i> neighbors;
+    if (!m_Map.isInside(toPoint(m_StartPosition)) || !m_Map.isInside(toPoint(m_EndPosition)))
+        return;
 
-    if (!isNodeOnEdge(node))
-    {
-        auto adjNodes = getAdjacentNodes(node,
-            { Direction::North, Direction::East, Direction::South, Direction::West });
-        neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-    }
-    else if (isNodeOnLeft(node))
+    // Start and end in different regions need no search at all
+    if (!m_Components.mayBeConnected(toPoint(m_StartPosition), toPoint(m_EndPosition)))
     {
-        if (isNodeOnTop(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::East, Direction::South });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else if (isNodeOnBottom(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::North, Direction::East });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else
-        {
-            auto adjNodes = getAdjacentNodes(node,
-                { Direction::North, Direction::East, Direction::South });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
+        std::printf("Found no path :(\n");
+        return;
     }
-    else if (isNodeOnRight(node))
+
+    if (canSearchMaze())
     {
-        if (isNodeOnTop(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::South, Direction::West });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else if (isNodeOnBottom(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::West, Direction::North });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else
-        {
-            auto adjNodes = getAdjacentNodes(node,
-                { Direction::South, Direction::West, Direction::North });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
+        Point start = { m_StartPosition.x / 2, m_StartPosition.y / 2 };
+        Point end = { m_EndPosition.x / 2, m_EndPosition.y / 2 };
+
+        m_HasFoundPath = m_MazeSearch->findPath(start, end);
+        MazeMap::toGridPath(m_MazeSearch->getPath(), m_Path);
     }
-    else if (isNodeOnTop(node))
+    else
     {
-        if (isNodeOnLeft(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::East, Direction::South });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else if (isNodeOnRight(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::South, Direction::West });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else
-        {
-            auto adjNodes = getAdjacentNodes(node,
-                { Direction::East, Direction::South, Direction::West });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
+        // Built on the first search that uses it, and again after edits,
+        // which leave it out of date
+        if (isUsingLandmarks() && !m_Landmarks->isCurrent())
+            m_Landmarks->build();
+
+        m_HasFoundPath = m_Search->findPath(toPoint(m_StartPosition), toPoint(m_EndPosition));
+        m_Path = m_Search->getPath();
     }
-    else if (isNodeOnBottom(node))
+
+    if (m_HasFoundPath)
     {
-        if (isNodeOnLeft(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::North, Direction::East });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else if (isNodeOnRight(node))
-        {
-            auto adjNodes = getAdjacentNodes(node, { Direction::West, Direction::North });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
-        else
-        {
-            auto adjNodes = getAdjacentNodes(node,
-                { Direction::West, Direction::North, Direction::East });
-            neighbors.insert(neighbors.end(), adjNodes.begin(), adjNodes.end());
-        }
+        std::printf("Found path: ");
+
+        printPath();
+        colorPath();
     }
 
-    return neighbors;
+    if (!m_HasFoundPath)
+        std::printf("Found no path :(\n");
 }
 
-sf::Vector2i Grid::getAdjacentNode(const sf::Vector2i& from, Direction direction) const
+void Grid::createSearch()
 {
-    sf::Vector2i adjacentNode(-1, -1);
-
-    switch (direction)
+    // Every block opened for a query would make the corridor graph rebuild
+    if (m_IsPruning && (m_Algorithm != SearchAlgorithm::Corridors))
+        m_Search.reset(new DeadEndPruning(m_Map, m_Algorithm));
+    else if (isUsingLandmarks())
     {
-        case Direction::North:
-            adjacentNode = { from.x, from.y - 1 };
-            break;
-        case Direction::NorthEast:
-            adjacentNode = { from.x + 1, from.y - 1 };
-            break;
-        case Direction::East:
-            adjacentNode = { from.x + 1, from.y };
-            break;
-        case Direction::SouthEast:
-            adjacentNode = { from.x + 1, from.y + 1 };
-            break;
-        case Direction::South:
-            adjacentNode = { from.x, from.y + 1 };
-            break;
-        case Direction::SouthWest:
-            adjacentNode = { from.x - 1, from.y + 1 };
-            break;
-        case Direction::West:
-            adjacentNode = { from.x - 1, from.y };
-            break;
-        case Direction::NorthWest:
-            adjacentNode = { from.x - 1, from.y - 1 };
-            break;
-        default:
-            break;
-    }
+        if (!m_Landmarks)
+            m_Landmarks.reset(new LandmarkTable(m_Map));
 
-    return adjacentNode;
+        m_Search = PathfinderFactory::createLandmarkAStar(m_Map, *m_Landmarks);
+    }
+    else
+        m_Search = PathfinderFactory::create(m_Map, m_Algorithm);
 }
 
-std::vector<sf::Vector2i> Grid::getAdjacentNodes(const sf::Vector2i& from, const std::vector<Direction>& directions) const
+bool Grid::isUsingLandmarks() const
 {
-    std::vector<sf::Vector2i> adjacentNodes;
-
-    for (const auto& direction : directions)
-    {
-        adjacentNodes.push_back(getAdjacentNode(from, direction));
-    }
-
-    return adjacentNodes;
+    return m_IsMaze && !m_IsPruning && (m_Algorithm == SearchAlgorithm::AStar);
 }
 
-bool Grid::isNodeOnEdge(const sf::Vector2i& node) const
+bool Grid::canSearchMaze() const
 {
-    return (node.x == 0)
-        || (node.x == m_NumNodes - 1)
-        || (node.y == 0)
-        || (node.y == m_NumNodes - 1);
+    // Edits and diagonal moves change the revision. Maze cells have odd
+    // coordinates in the grid, the walls between them even ones.
+    return m_IsNativeMaze && m_MazeSearch && (m_Map.getRevision() == m_MazeRevision)
+        && (m_StartPosition.x % 2) && (m_StartPosition.y % 2)
+        && (m_EndPosition.x % 2) && (m_EndPosition.y % 2);
 }
 
-bool Grid::isNodeOnLeft(const sf::Vector2i& node) const
+void Grid::createNodes()
 {
-    return node.x == 0;
+    auto size = getNodeSize();
+    for (int x = 0; x < m_Map.getWidth(); ++x)
+    {
+        for (int y = 0; y < m_Map.getHeight(); ++y)
+        {
+            sf::Vector2i position(x, y);
+
+            Node node(position, size);
+            m_Nodes[getNodeIndex(position)] = node;
+        }
+    }
 }
 
-bool Grid::isNodeOnRight(const sf::Vector2i& node) const
+void Grid::createLines()
 {
-    return node.x == m_NumNodes - 1;
+    auto nodeSize = getNodeSize();
+    for (int x = 0; x < m_Map.getWidth(); ++x)
+    {
+        for (int y = 0; y < m_Map.getHeight(); ++y)
+        {
+            sf::RectangleShape shape;
+            shape.setFillColor(sf::Color::Black);
+            shape.setPosition(x * nodeSize.x, y * nodeSize.y);
+
+            // Horizontal line
+            shape.setSize({ GRID_SIZE.x, 1.f });
+            m_Lines.push_back(shape);
+
+            // Vertical line
+            shape.setSize({ 1.f, GRID_SIZE.y });
+            m_Lines.push_back(shape);
+        }
+    }
 }
 
-bool Grid::isNodeOnTop(const sf::Vector2i& node) const
+void Grid::colorWalls(const sf::Color& color)
 {
-    return node.y == 0;
+    for (auto wall : m_Map.getWalls())
+    {
+        auto position = m_Map.getCellPosition(wall);
+        if (m_Map.isInside(position))
+            m_Nodes[getNodeIndex({ position.x, position.y })].setColor(color);
+    }
 }
 
-bool Grid::isNodeOnBottom(const sf::Vector2i& node) const
+void Grid::drawNodes(sf::RenderTarget& target, sf::RenderStates states) const
 {
-    return node.y == m_NumNodes - 1;
+    for (auto& node : m_Nodes)
+        target.draw(node);
 }
 
-void Grid::buildPath(const sf::Vector2i& position)
+void Grid::drawLines(sf::RenderTarget& target, sf::RenderStates states) const
 {
-    auto& currentNode = m_Nodes[position.x][position.y];
-    auto parentPosition = currentNode.getParentPosition();
-
-    if ((parentPosition.x == -1) && (parentPosition.y == -1))
-    {
-        m_Path.push_back(position);
-        return;
-    }
-
-    m_Path.push_back(position);
-    buildPath(parentPosition);
+    for (auto& line : m_Lines)
+        target.draw(line);
 }
 
 void Grid::printPath()
 {
-    for (int i = m_Path.size() - 1; i >= 0; --i)
-    {
-        std::printf("(%i, %i)", m_Path[i].x, m_Path[i].y);
-        if (i > 0)
-            std::printf("->");
-
-            }
-
-    std::printf("\n");
+    m_PathWriter.write(m_Path);
 }
 
 void Grid::colorPath(const sf::Color& color)
 {
-    for (int i = m_Path.size() - 1; i >= 0; --i)
+    for (auto& position : m_Path)
     {
-        bool isStartCell = (sf::Vector2i(m_Path[i].x, m_Path[i].y) == m_StartPosition);
-        bool isEndCell = (sf::Vector2i(m_Path[i].x, m_Path[i].y) == m_EndPosition);
+        bool isStartCell = (position == toPoint(m_StartPosition));
+        bool isEndCell = (position == toPoint(m_EndPosition));
 
         if (!isStartCell && !isEndCell)
         {
-            m_Nodes[m_Path[i].x][m_Path[i].y].setColor(color);
+            m_Nodes[getNodeIndex({ position.x, position.y })].setColor(color);
         }
     }
 }
+
+int Grid::getNodeIndex(const sf::Vector2i& position) const
+{
+    return position.y * m_Map.getWidth() + position.x;
+}
+
+Point Grid::toPoint(const sf::Vector2i& position)
+{
+    return { position.x, position.y };
+}
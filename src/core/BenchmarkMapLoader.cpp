@@ -0,0 +1,82 @@
+#include "core/BenchmarkMapLoader.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    bool isPassable(char tile)
+    {
+        return (tile == '.') || (tile == 'G') || (tile == 'S');
+    }
+}
+
+BenchmarkMapLoader::BenchmarkMapLoader(const std::string& file)
+    : m_File(file)
+{
+
+}
+
+bool BenchmarkMapLoader::isBenchmarkMap(const std::string& file)
+{
+    std::ifstream inputFile(file);
+
+    std::string key;
+    return (inputFile >> key) && (key == "type");
+}
+
+bool BenchmarkMapLoader::load(GridMap& map) const
+{
+    std::ifstream inputFile(m_File);
+
+    int width = -1;
+    int height = -1;
+    std::string line;
+    while (std::getline(inputFile, line))
+    {
+        std::stringstream strStream(line);
+        std::string key;
+        strStream >> key;
+
+        if (key == "height")
+            strStream >> height;
+        else if (key == "width")
+            strStream >> width;
+        else if (key == "map")
+            break;
+    }
+
+    if ((width <= 0) || (height <= 0))
+    {
+        std::cerr << "Error parsing " << m_File << ", it has no map size!" << std::endl;
+        return false;
+    }
+
+    map.resize(width, height);
+    map.setConnectivity(Connectivity::Eight);
+    map.setCornerCutting(CornerCutting::Never);
+
+    // Walls are added a run at a time
+    for (int y = 0; y < height; ++y)
+    {
+        if (!std::getline(inputFile, line))
+            line.clear();
+
+        int x = 0;
+        while (x < width)
+        {
+            auto runStart = x;
+            while ((x < width) && ((x >= static_cast<int>(line.size())) || !isPassable(line[x])))
+                ++x;
+
+            if (x > runStart)
+                map.addWallRow(y, runStart, x);
+
+            while ((x < width) && (x < static_cast<int>(line.size())) && isPassable(line[x]))
+                ++x;
+        }
+    }
+
+    return true;
+}
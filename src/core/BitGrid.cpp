@@ -0,0 +1,257 @@
+#include "core/BitGrid.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+// Passed by reference to std::min, so it needs a definition
+const int BitGrid::BITS_PER_WORD;
+
+BitGrid::Iterator::Iterator(const BitGrid& grid, int wordIndex)
+    : m_Grid(&grid)
+    , m_WordIndex(wordIndex)
+    , m_Remaining(0)
+{
+    if (m_WordIndex < static_cast<int>(m_Grid->getNumWords()))
+    {
+        m_Remaining = m_Grid->m_Data[m_WordIndex];
+        skipEmptyWords();
+    }
+}
+
+int BitGrid::Iterator::operator*() const
+{
+    return m_WordIndex * BITS_PER_WORD + __builtin_ctzll(m_Remaining);
+}
+
+BitGrid::Iterator& BitGrid::Iterator::operator++()
+{
+    // Clear the lowest set bit
+    m_Remaining &= m_Remaining - 1;
+    skipEmptyWords();
+
+    return *this;
+}
+
+bool BitGrid::Iterator::operator==(const Iterator& other) const
+{
+    return (m_WordIndex == other.m_WordIndex) && (m_Remaining == other.m_Remaining);
+}
+
+bool BitGrid::Iterator::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+void BitGrid::Iterator::skipEmptyWords()
+{
+    int numWords = m_Grid->getNumWords();
+
+    while (m_Remaining == 0)
+    {
+        if (++m_WordIndex >= numWords)
+        {
+            m_WordIndex = numWords;
+            return;
+        }
+
+        m_Remaining = m_Grid->m_Data[m_WordIndex];
+    }
+}
+
+BitGrid::BitGrid()
+    : m_Width(0)
+    , m_Height(0)
+    , m_WordsPerRow(0)
+    , m_Data(nullptr)
+    , m_IsView(false)
+{
+
+}
+
+BitGrid::BitGrid(int width, int height)
+    : BitGrid()
+{
+    resize(width, height);
+}
+
+BitGrid::BitGrid(const BitGrid& other)
+    : m_Width(other.m_Width)
+    , m_Height(other.m_Height)
+    , m_WordsPerRow(other.m_WordsPerRow)
+    , m_Words(other.m_Words)
+    , m_Data(other.m_IsView ? other.m_Data : m_Words.data())
+    , m_IsView(other.m_IsView)
+{
+
+}
+
+BitGrid& BitGrid::operator=(const BitGrid& other)
+{
+    if (this != &other)
+    {
+        m_Width = other.m_Width;
+        m_Height = other.m_Height;
+        m_WordsPerRow = other.m_WordsPerRow;
+        m_Words = other.m_Words;
+        m_Data = other.m_IsView ? other.m_Data : m_Words.data();
+        m_IsView = other.m_IsView;
+    }
+
+    return *this;
+}
+
+void BitGrid::resize(int width, int height)
+{
+    m_Width = width;
+    m_Height = height;
+    m_WordsPerRow = (width + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    m_Words.assign(m_WordsPerRow * m_Height, 0);
+    m_Data = m_Words.data();
+    m_IsView = false;
+}
+
+void BitGrid::view(int width, int height, Word* words)
+{
+    m_Width = width;
+    m_Height = height;
+    m_WordsPerRow = (width + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    std::vector<Word>().swap(m_Words);
+    m_Data = words;
+    m_IsView = true;
+}
+
+bool BitGrid::isView() const
+{
+    return m_IsView;
+}
+
+int BitGrid::getWidth() const
+{
+    return m_Width;
+}
+
+int BitGrid::getHeight() const
+{
+    return m_Height;
+}
+
+int BitGrid::getWordsPerRow() const
+{
+    return m_WordsPerRow;
+}
+
+int BitGrid::getStride() const
+{
+    return m_WordsPerRow * BITS_PER_WORD;
+}
+
+bool BitGrid::test(int x, int y) const
+{
+    return (m_Data[getWordIndex(x, y)] & getBitMask(x)) != 0;
+}
+
+void BitGrid::set(int x, int y)
+{
+    m_Data[getWordIndex(x, y)] |= getBitMask(x);
+}
+
+void BitGrid::clear(int x, int y)
+{
+    m_Data[getWordIndex(x, y)] &= ~getBitMask(x);
+}
+
+bool BitGrid::test(int index) const
+{
+    return (m_Data[index / BITS_PER_WORD] & getBitMask(index)) != 0;
+}
+
+void BitGrid::set(int index)
+{
+    m_Data[index / BITS_PER_WORD] |= getBitMask(index);
+}
+
+void BitGrid::clear(int index)
+{
+    m_Data[index / BITS_PER_WORD] &= ~getBitMask(index);
+}
+
+void BitGrid::fillRow(int y, int beginX, int endX)
+{
+    assert((beginX >= 0) && (endX <= m_Width) && (beginX <= endX));
+
+    auto rowStart = y * m_WordsPerRow;
+    for (auto word = beginX / BITS_PER_WORD; word * BITS_PER_WORD < endX; ++word)
+    {
+        auto beginBit = std::max(beginX - word * BITS_PER_WORD, 0);
+        auto endBit = std::min(endX - word * BITS_PER_WORD, BITS_PER_WORD);
+        m_Data[rowStart + word] |= getRangeMask(beginBit, endBit);
+    }
+}
+
+void BitGrid::clearRow(int y, int beginX, int endX)
+{
+    assert((beginX >= 0) && (endX <= m_Width) && (beginX <= endX));
+
+    auto rowStart = y * m_WordsPerRow;
+    for (auto word = beginX / BITS_PER_WORD; word * BITS_PER_WORD < endX; ++word)
+    {
+        auto beginBit = std::max(beginX - word * BITS_PER_WORD, 0);
+        auto endBit = std::min(endX - word * BITS_PER_WORD, BITS_PER_WORD);
+        m_Data[rowStart + word] &= ~getRangeMask(beginBit, endBit);
+    }
+}
+
+void BitGrid::clearAll()
+{
+    std::fill(m_Data, m_Data + getNumWords(), 0);
+}
+
+int BitGrid::count() const
+{
+    int total = 0;
+
+    for (int i = 0; i < getNumWords(); ++i)
+        total += __builtin_popcountll(m_Data[i]);
+
+    return total;
+}
+
+const BitGrid::Word* BitGrid::getWords() const
+{
+    return m_Data;
+}
+
+int BitGrid::getNumWords() const
+{
+    return m_WordsPerRow * m_Height;
+}
+
+BitGrid::Iterator BitGrid::begin() const
+{
+    return Iterator(*this, 0);
+}
+
+BitGrid::Iterator BitGrid::end() const
+{
+    return Iterator(*this, getNumWords());
+}
+
+int BitGrid::getWordIndex(int x, int y) const
+{
+    assert((x >= 0) && (x < m_Width) && (y >= 0) && (y < m_Height));
+
+    return y * m_WordsPerRow + x / BITS_PER_WORD;
+}
+
+BitGrid::Word BitGrid::getBitMask(int x)
+{
+    return Word(1) << (x % BITS_PER_WORD);
+}
+
+BitGrid::Word BitGrid::getRangeMask(int beginBit, int endBit)
+{
+    auto upper = (endBit == BITS_PER_WORD) ? ~Word(0) : ((Word(1) << endBit) - 1);
+    auto lower = (Word(1) << beginBit) - 1;
+
+    return upper & ~lower;
+}
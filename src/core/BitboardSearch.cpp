@@ -0,0 +1,204 @@
+#include "core/BitboardSearch.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+
+// GCC and Clang can build a function for AVX2 whatever the target flags,
+// so the vector loop is always compiled on x86 and picked at run time
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BITBOARD_HAS_AVX2_PATH
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    typedef BitGrid::Word Word;
+
+#ifdef BITBOARD_HAS_AVX2_PATH
+    // BitboardSearch::expand four words at a time. Returns the index of
+    // the first word left for the scalar loop.
+    __attribute__((target("avx2")))
+    int expandAvx2(const Word* frontier, const Word* previous, const Word* passable, Word* next, int stride,
+                   int index, int end)
+    {
+        for (; index + 4 <= end; index += 4)
+        {
+            auto center = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + index));
+            auto left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + index - 1));
+            auto right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + index + 1));
+            auto up = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + index - stride));
+            auto down = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + index + stride));
+
+            auto east = _mm256_or_si256(_mm256_slli_epi64(center, 1), _mm256_srli_epi64(left, 63));
+            auto west = _mm256_or_si256(_mm256_srli_epi64(center, 1), _mm256_slli_epi64(right, 63));
+            auto spread = _mm256_or_si256(_mm256_or_si256(east, west), _mm256_or_si256(up, down));
+
+            auto open = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(passable + index));
+            auto seen = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + index));
+            auto result = _mm256_andnot_si256(seen, _mm256_and_si256(spread, open));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(next + index), result);
+        }
+
+        return index;
+    }
+#endif
+
+    bool hasAvx2()
+    {
+#ifdef BITBOARD_HAS_AVX2_PATH
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+}
+
+BitboardSearch::BitboardSearch(const GridMap& map)
+    : m_Map(map)
+    , m_Revision(0)
+    , m_IsPrepared(false)
+    , m_WordsPerRow(0)
+    , m_UsesAvx2(hasAvx2())
+{
+
+}
+
+bool BitboardSearch::usesAvx2() const
+{
+    return m_UsesAvx2;
+}
+
+bool BitboardSearch::isReachable(const Point& start, const Point& goal)
+{
+    return getDistance(start, goal) != -1;
+}
+
+int BitboardSearch::getDistance(const Point& start, const Point& goal)
+{
+    prepare();
+
+    auto startCell = m_Map.getCellIndex(start);
+    auto goalCell = m_Map.getCellIndex(goal);
+    if (m_Map.isWall(startCell) || m_Map.isWall(goalCell))
+        return -1;
+    if (startCell == goalCell)
+        return 0;
+
+    for (auto layer : { &m_Previous, &m_Frontier, &m_Next })
+    {
+        std::fill(layer->words.begin() + layer->beginRow * m_WordsPerRow,
+                  layer->words.begin() + layer->endRow * m_WordsPerRow, 0);
+        layer->beginRow = layer->endRow = 0;
+    }
+
+    auto startRow = start.y + 1;
+    m_Frontier.words[startCell / BitGrid::BITS_PER_WORD] |= Word(1) << (startCell % BitGrid::BITS_PER_WORD);
+    m_Frontier.beginRow = startRow;
+    m_Frontier.endRow = startRow + 1;
+
+    auto goalWord = goalCell / BitGrid::BITS_PER_WORD;
+    auto goalMask = Word(1) << (goalCell % BitGrid::BITS_PER_WORD);
+
+    // Only the rows next to the frontier can change, and the wall border
+    // keeps them inside rows 1 to height
+    for (int distance = 1; ; ++distance)
+    {
+        auto beginRow = std::max(1, m_Frontier.beginRow - 1);
+        auto endRow = std::min(m_Map.getHeight() + 1, m_Frontier.endRow + 1);
+
+        std::fill(m_Next.words.begin() + m_Next.beginRow * m_WordsPerRow,
+                  m_Next.words.begin() + m_Next.endRow * m_WordsPerRow, 0);
+        expand(beginRow, endRow);
+        m_Next.beginRow = beginRow;
+        m_Next.endRow = endRow;
+
+        if (m_Next.words[goalWord] & goalMask)
+            return distance;
+
+        if (!trimRows(m_Next))
+            return -1;
+
+        std::swap(m_Previous, m_Frontier);
+        std::swap(m_Frontier, m_Next);
+    }
+}
+
+void BitboardSearch::prepare()
+{
+    if (m_IsPrepared && (m_Revision == m_Map.getRevision()))
+        return;
+
+    auto& walls = m_Map.getWalls();
+    m_WordsPerRow = walls.getWordsPerRow();
+
+    auto numWords = static_cast<std::size_t>(m_WordsPerRow) * walls.getHeight();
+    m_Passable.assign(numWords, 0);
+    for (auto layer : { &m_Previous, &m_Frontier, &m_Next })
+    {
+        layer->words.assign(numWords, 0);
+        layer->beginRow = layer->endRow = 0;
+    }
+
+    // The words past the right hand border are row padding, not free
+    // cells, so only bits inside the border are passable
+    std::vector<Word> rowMask(m_WordsPerRow, 0);
+    for (int x = 1; x <= m_Map.getWidth(); ++x)
+        rowMask[x / BitGrid::BITS_PER_WORD] |= Word(1) << (x % BitGrid::BITS_PER_WORD);
+
+    for (int y = 1; y <= m_Map.getHeight(); ++y)
+    {
+        for (int i = 0; i < m_WordsPerRow; ++i)
+        {
+            auto index = y * m_WordsPerRow + i;
+            m_Passable[index] = ~walls.getWords()[index] & rowMask[i];
+        }
+    }
+
+    m_Revision = m_Map.getRevision();
+    m_IsPrepared = true;
+}
+
+void BitboardSearch::expand(int beginRow, int endRow)
+{
+    // Rows are contiguous and every row ends in a border or padding bit
+    // that is never in the frontier, so the words can be treated as one
+    // long bit string: carries across a row end always shift in zeros
+    const auto stride = m_WordsPerRow;
+    const auto frontier = m_Frontier.words.data();
+    const auto previous = m_Previous.words.data();
+    const auto passable = m_Passable.data();
+    auto next = m_Next.words.data();
+
+    auto index = beginRow * stride;
+    auto end = endRow * stride;
+
+#ifdef BITBOARD_HAS_AVX2_PATH
+    if (m_UsesAvx2)
+        index = expandAvx2(frontier, previous, passable, next, stride, index, end);
+#endif
+
+    for (; index < end; ++index)
+    {
+        auto east = (frontier[index] << 1) | (frontier[index - 1] >> 63);
+        auto west = (frontier[index] >> 1) | (frontier[index + 1] << 63);
+        auto spread = east | west | frontier[index - stride] | frontier[index + stride];
+
+        next[index] = spread & passable[index] & ~previous[index];
+    }
+}
+
+bool BitboardSearch::trimRows(Layer& layer) const
+{
+    auto isEmptyRow = [&](int row)
+    {
+        auto first = layer.words.begin() + row * m_WordsPerRow;
+        return std::all_of(first, first + m_WordsPerRow, [](Word word) { return word == 0; });
+    };
+
+    while ((layer.beginRow < layer.endRow) && isEmptyRow(layer.beginRow))
+        ++layer.beginRow;
+    while ((layer.endRow > layer.beginRow) && isEmptyRow(layer.endRow - 1))
+        --layer.endRow;
+
+    return layer.beginRow < layer.endRow;
+}
@@ -0,0 +1,231 @@
+#include "core/ConnectedComponents.hpp"
+
+#include <algorithm>
+
+// Enough to walk around a wall drawn into open space or along another
+// wall, where its neighbours meet again within a few steps
+const int ConnectedComponents::MAX_LOCAL_SEARCH = 1024;
+
+ConnectedComponents::ConnectedComponents(const GridMap& map)
+    : m_Map(map)
+    , m_Generation(0)
+    , m_Revision(0)
+    , m_IsStale(true)
+{
+    m_Map.addListener(this);
+}
+
+ConnectedComponents::~ConnectedComponents()
+{
+    m_Map.removeListener(this);
+}
+
+bool ConnectedComponents::mayBeConnected(const Point& from, const Point& to)
+{
+    update();
+
+    auto fromCell = m_Map.getCellIndex(from);
+    auto toCell = m_Map.getCellIndex(to);
+    if (m_Map.isWall(fromCell) || m_Map.isWall(toCell))
+        return false;
+
+    return find(fromCell) == find(toCell);
+}
+
+void ConnectedComponents::invalidate()
+{
+    m_IsStale = true;
+}
+
+void ConnectedComponents::update()
+{
+    if (m_IsStale || (m_Revision != m_Map.getRevision()))
+        rebuild();
+}
+
+void ConnectedComponents::onWallAdded(const Point& position)
+{
+    // The map counts the change before telling its listeners, so the
+    // labels can only be patched if they were current just before it.
+    // Otherwise the revision has moved on and the next query relabels.
+    if (m_IsStale || (m_Revision + 1 != m_Map.getRevision()))
+        return;
+
+    auto cell = m_Map.getCellIndex(position);
+    if (isRegionWhole(cell))
+    {
+        m_IsLabelledWall[cell] = true;
+        m_Revision = m_Map.getRevision();
+    }
+}
+
+void ConnectedComponents::onWallRemoved(const Point& position)
+{
+    if (m_IsStale || (m_Revision + 1 != m_Map.getRevision()))
+        return;
+
+    auto cell = m_Map.getCellIndex(position);
+
+    // A wall added since the last rebuild still carries its old region's
+    // label, which is only right if it is next to that region again
+    if (m_IsLabelledWall[cell])
+    {
+        auto region = find(cell);
+
+        bool isInRegion = false;
+        for (int i = 0; i < m_Map.getNumDirections(); ++i)
+        {
+            auto direction = m_Map.getDirections()[i];
+            if (m_Map.canMove(cell, direction) && (find(cell + m_Map.getOffset(direction)) == region))
+                isInRegion = true;
+        }
+
+        if (!isInRegion)
+            return;
+
+        m_IsLabelledWall[cell] = false;
+    }
+
+    // Joining the cell to its neighbours is enough: any diagonal move the
+    // wall used to block runs between two of its cardinal neighbours, and
+    // those are now joined through the cell
+    for (int i = 0; i < m_Map.getNumDirections(); ++i)
+    {
+        auto direction = m_Map.getDirections()[i];
+        if (m_Map.canMove(cell, direction))
+            unite(cell, cell + m_Map.getOffset(direction));
+    }
+
+    m_Revision = m_Map.getRevision();
+}
+
+void ConnectedComponents::onMapChanged()
+{
+    m_IsStale = true;
+}
+
+void ConnectedComponents::rebuild()
+{
+    auto numCells = m_Map.getNumCells();
+    m_Parents.resize(numCells);
+    for (int cell = 0; cell < numCells; ++cell)
+        m_Parents[cell] = cell;
+
+    m_IsLabelledWall.assign(numCells, false);
+    m_Marks.resize(numCells, 0);
+
+    // Moves are symmetric, so joining each cell to the neighbours already
+    // visited (above it and to its left) covers every move once
+    static const Direction backwards[4] =
+    {
+        Direction::West, Direction::NorthWest, Direction::North, Direction::NorthEast
+    };
+
+    bool eightConnected = (m_Map.getConnectivity() == Connectivity::Eight);
+    for (int y = 0; y < m_Map.getHeight(); ++y)
+    {
+        for (int x = 0; x < m_Map.getWidth(); ++x)
+        {
+            auto cell = m_Map.getCellIndex({ x, y });
+            if (m_Map.isWall(cell))
+                continue;
+
+            for (auto direction : backwards)
+            {
+                if (!eightConnected && GridMap::isDiagonal(direction))
+                    continue;
+
+                if (m_Map.canMove(cell, direction))
+                    unite(cell, cell + m_Map.getOffset(direction));
+            }
+        }
+    }
+
+    // Point every cell straight at its root so the first queries are a
+    // single lookup each
+    for (int cell = 0; cell < numCells; ++cell)
+        m_Parents[cell] = find(cell);
+
+    m_Revision = m_Map.getRevision();
+    m_IsStale = false;
+}
+
+bool ConnectedComponents::isRegionWhole(int cell)
+{
+    // Every move the wall breaks either enters the cell or is a diagonal
+    // past it, so both of its ends are next to the cell. If the free
+    // neighbours that shared its region still reach each other, every
+    // path through the region can be rerouted around the wall.
+    auto region = find(cell);
+
+    int neighbours[8];
+    int numNeighbours = 0;
+    for (int i = 0; i < m_Map.getNumDirections(); ++i)
+    {
+        auto neighbour = cell + m_Map.getOffset(m_Map.getDirections()[i]);
+        if (!m_Map.isWall(neighbour) && (find(neighbour) == region))
+            neighbours[numNeighbours++] = neighbour;
+    }
+
+    if (numNeighbours < 2)
+        return true;
+
+    ++m_Generation;
+    if (m_Generation == 0)
+    {
+        std::fill(m_Marks.begin(), m_Marks.end(), 0);
+        m_Generation = 1;
+    }
+
+    m_Queue.clear();
+    m_Queue.push_back(neighbours[0]);
+    m_Marks[neighbours[0]] = m_Generation;
+
+    int numFound = 1;
+    for (std::size_t i = 0; (i < m_Queue.size()) && (i < static_cast<std::size_t>(MAX_LOCAL_SEARCH)); ++i)
+    {
+        auto current = m_Queue[i];
+        for (int j = 0; j < m_Map.getNumDirections(); ++j)
+        {
+            auto direction = m_Map.getDirections()[j];
+            auto next = current + m_Map.getOffset(direction);
+            if ((m_Marks[next] == m_Generation) || !m_Map.canMove(current, direction))
+                continue;
+
+            m_Marks[next] = m_Generation;
+            m_Queue.push_back(next);
+
+            if ((std::find(neighbours, neighbours + numNeighbours, next) != neighbours + numNeighbours)
+                && (++numFound == numNeighbours))
+                return true;
+        }
+    }
+
+    // Either the region split or the search gave up before finding out
+    return false;
+}
+
+int ConnectedComponents::find(int cell)
+{
+    // Path halving: every other node on the way up skips to its grandparent
+    while (m_Parents[cell] != cell)
+    {
+        m_Parents[cell] = m_Parents[m_Parents[cell]];
+        cell = m_Parents[cell];
+    }
+
+    return cell;
+}
+
+void ConnectedComponents::unite(int first, int second)
+{
+    auto firstRoot = find(first);
+    auto secondRoot = find(second);
+
+    // Joining under the lower index keeps the trees shallow enough with
+    // the path halving in find, without storing ranks
+    if (firstRoot < secondRoot)
+        m_Parents[secondRoot] = firstRoot;
+    else if (secondRoot < firstRoot)
+        m_Parents[firstRoot] = secondRoot;
+}
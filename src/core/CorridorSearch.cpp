@@ -0,0 +1,376 @@
+#include "core/CorridorSearch.hpp"
+
+#include "core/Heuristics.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    // Marks a corridor cell in m_CellEdges while the graph is built,
+    // until the walk along its corridor reaches it
+    const int UNWALKED = -2;
+}
+
+CorridorSearch::CorridorSearch(const GridMap& map)
+    : m_Map(map)
+    , m_IsStale(true)
+    , m_NumNodes(0)
+    , m_StartCell(-1)
+    , m_GoalCell(-1)
+    , m_Space(map)
+{
+    m_Map.addListener(this);
+}
+
+CorridorSearch::~CorridorSearch()
+{
+    m_Map.removeListener(this);
+}
+
+bool CorridorSearch::findPath(const Point& start, const Point& goal)
+{
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    if (m_IsStale)
+        build();
+
+    m_StartCell = m_Map.getCellIndex(start);
+    m_GoalCell = m_Map.getCellIndex(goal);
+    if (m_Map.isWall(m_StartCell) || m_Map.isWall(m_GoalCell))
+        return false;
+
+    if (m_StartCell == m_GoalCell)
+    {
+        m_Path.push_back(start);
+        return true;
+    }
+
+    m_Space.prepare();
+    if (m_OpenSet.getCapacity() != m_Map.getNumCells())
+        m_OpenSet.resize(m_Map.getNumCells());
+
+    m_OpenSet.clear();
+
+    auto& startNode = m_Space.getNode(m_StartCell);
+    startNode.parent = -1;
+    startNode.movementCost = 0;
+    m_Space.setState(m_StartCell, CellState::Open);
+    m_OpenSet.push(m_StartCell, { getHeuristic(m_StartCell, m_GoalCell), 0 });
+
+    while (!m_OpenSet.isEmpty())
+    {
+        auto currentCell = m_OpenSet.pop();
+        if (currentCell == m_GoalCell)
+        {
+            buildPath();
+            return true;
+        }
+
+        m_Space.setState(currentCell, CellState::Closed);
+        ++m_NumExpansions;
+
+        // Only the start can be a corridor cell here: the goal ends the
+        // search, and edges only lead to nodes and the goal
+        if (m_CellEdges[currentCell] == -1)
+            expandNode(currentCell);
+        else
+            expandCorridorCell(currentCell);
+    }
+
+    return false;
+}
+
+void CorridorSearch::onWallAdded(const Point&)
+{
+    m_IsStale = true;
+}
+
+void CorridorSearch::onWallRemoved(const Point&)
+{
+    m_IsStale = true;
+}
+
+void CorridorSearch::onMapChanged()
+{
+    m_IsStale = true;
+}
+
+int CorridorSearch::getNumNodes() const
+{
+    return m_NumNodes;
+}
+
+int CorridorSearch::getNumEdges() const
+{
+    return m_Edges.size();
+}
+
+void CorridorSearch::build()
+{
+    auto numCells = m_Map.getNumCells();
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    m_Edges.clear();
+    m_CorridorCells.clear();
+    m_CellEdges.assign(numCells, -1);
+    m_CellNumbers.assign(numCells, 0);
+    m_CellCosts.assign(numCells, 0);
+    m_ParentSteps.resize(numCells);
+
+    std::vector<int> nodes;
+    for (int y = 0; y < m_Map.getHeight(); ++y)
+    {
+        for (int x = 0; x < m_Map.getWidth(); ++x)
+        {
+            auto cell = m_Map.getCellIndex({ x, y });
+            if (m_Map.isWall(cell))
+                continue;
+
+            if (getNumMoves(cell) == 2)
+                m_CellEdges[cell] = UNWALKED;
+            else
+                nodes.push_back(cell);
+        }
+    }
+
+    auto walkFrom = [&](int node)
+    {
+        for (int i = 0; i < numDirections; ++i)
+        {
+            if (m_Map.canMove(node, directions[i]))
+                walkCorridor(node, directions[i]);
+        }
+    };
+
+    for (auto node : nodes)
+        walkFrom(node);
+
+    // Whatever is left lies on loops with no node on them
+    for (int cell = 0; cell < numCells; ++cell)
+    {
+        if (m_CellEdges[cell] != UNWALKED)
+            continue;
+
+        m_CellEdges[cell] = -1;
+        nodes.push_back(cell);
+        walkFrom(cell);
+    }
+
+    m_NumNodes = nodes.size();
+
+    // A loop is listed once at its node, and expandNode walks it both ways
+    m_AdjacencyStarts.assign(numCells + 1, 0);
+    for (auto& edge : m_Edges)
+    {
+        ++m_AdjacencyStarts[edge.from + 1];
+        if (edge.to != edge.from)
+            ++m_AdjacencyStarts[edge.to + 1];
+    }
+
+    for (int cell = 0; cell < numCells; ++cell)
+        m_AdjacencyStarts[cell + 1] += m_AdjacencyStarts[cell];
+
+    m_AdjacentEdges.resize(m_AdjacencyStarts.back());
+    std::vector<int> next(m_AdjacencyStarts.begin(), m_AdjacencyStarts.end() - 1);
+    for (int i = 0; i < static_cast<int>(m_Edges.size()); ++i)
+    {
+        m_AdjacentEdges[next[m_Edges[i].from]++] = i;
+        if (m_Edges[i].to != m_Edges[i].from)
+            m_AdjacentEdges[next[m_Edges[i].to]++] = i;
+    }
+
+    m_IsStale = false;
+}
+
+int CorridorSearch::getNumMoves(int cell) const
+{
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    int numMoves = 0;
+    for (int i = 0; i < numDirections; ++i)
+    {
+        if (m_Map.canMove(cell, directions[i]))
+            ++numMoves;
+    }
+
+    return numMoves;
+}
+
+void CorridorSearch::walkCorridor(int node, Direction direction)
+{
+    auto cell = node + m_Map.getOffset(direction);
+    auto cost = GridCost::getStepCost(direction);
+
+    // Two nodes side by side are joined by an edge with no cells of its
+    // own, added from the lower numbered one
+    if (m_CellEdges[cell] == -1)
+    {
+        if (node < cell)
+            m_Edges.push_back({ node, cell, cost, 0, 0 });
+
+        return;
+    }
+
+    // Already walked from its other end
+    if (m_CellEdges[cell] != UNWALKED)
+        return;
+
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    auto edge = static_cast<int>(m_Edges.size());
+    auto cellsBegin = static_cast<int>(m_CorridorCells.size());
+    auto previous = node;
+
+    while (m_CellEdges[cell] == UNWALKED)
+    {
+        m_CellEdges[cell] = edge;
+        m_CellNumbers[cell] = m_CorridorCells.size() - cellsBegin + 1;
+        m_CellCosts[cell] = cost;
+        m_CorridorCells.push_back(cell);
+
+        // A corridor cell has one move back and one move on
+        for (int i = 0; i < numDirections; ++i)
+        {
+            auto neighbor = cell + m_Map.getOffset(directions[i]);
+            if ((neighbor != previous) && m_Map.canMove(cell, directions[i]))
+            {
+                previous = cell;
+                cell = neighbor;
+                cost += GridCost::getStepCost(directions[i]);
+                break;
+            }
+        }
+    }
+
+    m_Edges.push_back({ node, cell, cost, cellsBegin, static_cast<int>(m_CorridorCells.size()) });
+}
+
+int CorridorSearch::getCell(const Edge& edge, int number) const
+{
+    if (number == 0)
+        return edge.from;
+
+    if (number == edge.getLength() - 1)
+        return edge.to;
+
+    return m_CorridorCells[edge.cellsBegin + number - 1];
+}
+
+void CorridorSearch::relax(int currentCell, int neighborCell, int cost, const Step& step)
+{
+    auto neighborState = m_Space.getState(neighborCell);
+    if (neighborState == CellState::Closed)
+        return;
+
+    auto tentativeMovementCost = m_Space.getNode(currentCell).movementCost + cost;
+
+    bool neighborInOpenSet = (neighborState == CellState::Open);
+    auto& neighborNode = m_Space.getNode(neighborCell);
+    if (neighborInOpenSet && (tentativeMovementCost >= neighborNode.movementCost))
+        return;
+
+    neighborNode.parent = currentCell;
+    neighborNode.movementCost = tentativeMovementCost;
+    m_ParentSteps[neighborCell] = step;
+
+    SearchKey key = { tentativeMovementCost + getHeuristic(neighborCell, m_GoalCell),
+                      tentativeMovementCost };
+    if (neighborInOpenSet)
+    {
+        m_OpenSet.decreaseKey(neighborCell, key);
+    }
+    else
+    {
+        m_OpenSet.push(neighborCell, key);
+        m_Space.setState(neighborCell, CellState::Open);
+    }
+}
+
+void CorridorSearch::expandNode(int cell)
+{
+    for (auto i = m_AdjacencyStarts[cell]; i < m_AdjacencyStarts[cell + 1]; ++i)
+    {
+        auto& edge = m_Edges[m_AdjacentEdges[i]];
+        auto last = edge.getLength() - 1;
+
+        if (edge.from == cell)
+            relax(cell, edge.to, edge.cost, { m_AdjacentEdges[i], 0, last });
+
+        if (edge.to == cell)
+            relax(cell, edge.from, edge.cost, { m_AdjacentEdges[i], last, 0 });
+    }
+
+    // A goal inside a corridor is reached from either end of it
+    auto goalEdge = m_CellEdges[m_GoalCell];
+    if (goalEdge == -1)
+        return;
+
+    auto& edge = m_Edges[goalEdge];
+    auto goalNumber = m_CellNumbers[m_GoalCell];
+    auto goalCost = m_CellCosts[m_GoalCell];
+
+    if (edge.from == cell)
+        relax(cell, m_GoalCell, goalCost, { goalEdge, 0, goalNumber });
+
+    if (edge.to == cell)
+        relax(cell, m_GoalCell, edge.cost - goalCost, { goalEdge, edge.getLength() - 1, goalNumber });
+}
+
+void CorridorSearch::expandCorridorCell(int cell)
+{
+    auto edgeIndex = m_CellEdges[cell];
+    auto& edge = m_Edges[edgeIndex];
+    auto number = m_CellNumbers[cell];
+    auto cost = m_CellCosts[cell];
+
+    relax(cell, edge.from, cost, { edgeIndex, number, 0 });
+    relax(cell, edge.to, edge.cost - cost, { edgeIndex, number, edge.getLength() - 1 });
+
+    if (m_CellEdges[m_GoalCell] == edgeIndex)
+    {
+        auto goalNumber = m_CellNumbers[m_GoalCell];
+        relax(cell, m_GoalCell, std::abs(m_CellCosts[m_GoalCell] - cost), { edgeIndex, number, goalNumber });
+    }
+}
+
+void CorridorSearch::buildPath()
+{
+    m_PathCost = m_Space.getNode(m_GoalCell).movementCost;
+
+    m_PathSteps.clear();
+    for (auto cell = m_GoalCell; cell != m_StartCell; cell = m_Space.getNode(cell).parent)
+        m_PathSteps.push_back(m_ParentSteps[cell]);
+
+    std::reverse(m_PathSteps.begin(), m_PathSteps.end());
+
+    // Each step starts where the one before it ended
+    m_Path.push_back(m_Map.getCellPosition(m_StartCell));
+    for (auto& step : m_PathSteps)
+    {
+        auto& edge = m_Edges[step.edge];
+        auto increment = (step.end > step.begin) ? 1 : -1;
+
+        for (auto number = step.begin; number != step.end; )
+        {
+            number += increment;
+            m_Path.push_back(m_Map.getCellPosition(getCell(edge, number)));
+        }
+    }
+}
+
+int CorridorSearch::getHeuristic(int from, int to) const
+{
+    auto fromPosition = m_Map.getCellPosition(from);
+    auto toPosition = m_Map.getCellPosition(to);
+
+    if (m_Map.getConnectivity() == Connectivity::Eight)
+        return OctileHeuristic<GridCost>()(fromPosition, toPosition);
+
+    return ManhattanHeuristic<GridCost>()(fromPosition, toPosition);
+}
@@ -0,0 +1,291 @@
+#include "core/DStarLite.hpp"
+
+#include "core/Heuristics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+
+const int DStarLite::INFINITE_COST = INT_MAX / 2;
+
+DStarLite::DStarLite(const GridMap& map)
+    : m_Map(map)
+    , m_NeedsReset(true)
+    , m_StartCell(-1)
+    , m_GoalCell(-1)
+    , m_KeyModifier(0)
+{
+    m_Map.addListener(this);
+}
+
+DStarLite::~DStarLite()
+{
+    m_Map.removeListener(this);
+}
+
+bool DStarLite::findPath(const Point& start, const Point& goal)
+{
+    auto startCell = m_Map.getCellIndex(start);
+    auto goalCell = m_Map.getCellIndex(goal);
+
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    // A wall goal would still be seeded with a cost of 0, which the walk
+    // could then never step into. Edits stay queued for the next query.
+    if (m_Map.isWall(startCell) || m_Map.isWall(goalCell))
+        return false;
+
+    if (m_NeedsReset || (goalCell != m_GoalCell))
+    {
+        m_StartCell = startCell;
+        reset(goalCell);
+    }
+    else
+    {
+        if (startCell != m_StartCell)
+        {
+            m_KeyModifier += getHeuristic(m_StartCell, startCell);
+            m_StartCell = startCell;
+        }
+
+        // Each edited wall changes the moves in and out of the cells
+        // around it, so their lookaheads are worked out again
+        for (auto cell : m_ChangedCells)
+            updateLookahead(cell);
+    }
+
+    m_ChangedCells.clear();
+
+    computeShortestPath();
+
+    if (m_Costs[m_StartCell] >= INFINITE_COST)
+        return false;
+
+    // With both ends free the walk can only miss the goal if the costs
+    // are inconsistent
+    bool hasReachedGoal = buildPath();
+    assert(hasReachedGoal);
+
+    if (!hasReachedGoal)
+    {
+        m_Path.clear();
+        return false;
+    }
+
+    m_PathCost = m_Costs[m_StartCell];
+
+    return true;
+}
+
+void DStarLite::onWallAdded(const Point& position)
+{
+    onWallRemoved(position);
+}
+
+void DStarLite::onWallRemoved(const Point& position)
+{
+    if (m_NeedsReset)
+        return;
+
+    // The cell, plus every neighbour: diagonal moves that squeeze past the
+    // cell run between two of them
+    auto cell = m_Map.getCellIndex(position);
+    m_ChangedCells.push_back(cell);
+    for (auto direction : GridMap::ALL_DIRECTIONS)
+        m_ChangedCells.push_back(cell + m_Map.getOffset(direction));
+}
+
+void DStarLite::onMapChanged()
+{
+    m_NeedsReset = true;
+    m_ChangedCells.clear();
+}
+
+void DStarLite::reset(int goalCell)
+{
+    auto numCells = m_Map.getNumCells();
+    m_Costs.assign(numCells, INFINITE_COST);
+    m_Lookaheads.assign(numCells, INFINITE_COST);
+
+    if (m_OpenSet.getCapacity() != numCells)
+        m_OpenSet.resize(numCells);
+
+    m_OpenSet.clear();
+
+    m_GoalCell = goalCell;
+    m_KeyModifier = 0;
+    m_NeedsReset = false;
+
+    m_Lookaheads[m_GoalCell] = 0;
+    m_OpenSet.push(m_GoalCell, calculateKey(m_GoalCell));
+}
+
+void DStarLite::computeShortestPath()
+{
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    while (!m_OpenSet.isEmpty())
+    {
+        auto startKey = calculateKey(m_StartCell);
+        auto cell = m_OpenSet.top();
+        auto oldKey = m_OpenSet.getKey(cell);
+        if (!(oldKey < startKey) && (m_Lookaheads[m_StartCell] == m_Costs[m_StartCell]))
+            break;
+
+        ++m_NumExpansions;
+
+        // Queued before the start moved, so its key is out of date
+        auto newKey = calculateKey(cell);
+        if (oldKey < newKey)
+        {
+            m_OpenSet.updateKey(cell, newKey);
+            continue;
+        }
+
+        m_OpenSet.remove(cell);
+
+        if (m_Costs[cell] > m_Lookaheads[cell])
+        {
+            // Overconsistent: the cost went down, so settle it and offer
+            // it to the neighbours
+            m_Costs[cell] = m_Lookaheads[cell];
+            for (int i = 0; i < numDirections; ++i)
+            {
+                auto direction = directions[i];
+                if (!m_Map.canMove(cell, direction))
+                    continue;
+
+                // Moves are symmetric, so the neighbour can step back here
+                auto neighbor = cell + m_Map.getOffset(direction);
+                auto cost = GridCost::getStepCost(direction) + m_Costs[cell];
+                if ((neighbor != m_GoalCell) && (cost < m_Lookaheads[neighbor]))
+                {
+                    m_Lookaheads[neighbor] = cost;
+                    updateCell(neighbor);
+                }
+            }
+        }
+        else
+        {
+            // Underconsistent: the cost went up, so drop it and recheck
+            // every neighbour that may have been relying on it
+            auto oldCost = m_Costs[cell];
+            m_Costs[cell] = INFINITE_COST;
+
+            updateLookahead(cell);
+            for (int i = 0; i < numDirections; ++i)
+            {
+                auto direction = directions[i];
+                if (!m_Map.canMove(cell, direction))
+                    continue;
+
+                auto neighbor = cell + m_Map.getOffset(direction);
+                if (m_Lookaheads[neighbor] == GridCost::getStepCost(direction) + oldCost)
+                    updateLookahead(neighbor);
+            }
+        }
+    }
+}
+
+void DStarLite::updateCell(int cell)
+{
+    bool isQueued = m_OpenSet.contains(cell);
+    if (m_Costs[cell] != m_Lookaheads[cell])
+    {
+        if (isQueued)
+            m_OpenSet.updateKey(cell, calculateKey(cell));
+        else
+            m_OpenSet.push(cell, calculateKey(cell));
+    }
+    else if (isQueued)
+    {
+        m_OpenSet.remove(cell);
+    }
+}
+
+void DStarLite::updateLookahead(int cell)
+{
+    if (cell != m_GoalCell)
+    {
+        auto best = INFINITE_COST;
+        if (!m_Map.isWall(cell))
+        {
+            for (int i = 0; i < m_Map.getNumDirections(); ++i)
+            {
+                auto direction = m_Map.getDirections()[i];
+                if (!m_Map.canMove(cell, direction))
+                    continue;
+
+                auto neighborCost = m_Costs[cell + m_Map.getOffset(direction)];
+                if (neighborCost < INFINITE_COST)
+                    best = std::min(best, GridCost::getStepCost(direction) + neighborCost);
+            }
+        }
+
+        m_Lookaheads[cell] = best;
+    }
+
+    updateCell(cell);
+}
+
+ReplanKey DStarLite::calculateKey(int cell) const
+{
+    auto cost = std::min(m_Costs[cell], m_Lookaheads[cell]);
+    if (cost >= INFINITE_COST)
+        return { INFINITE_COST, INFINITE_COST };
+
+    return { cost + getHeuristic(m_StartCell, cell) + m_KeyModifier, cost };
+}
+
+int DStarLite::getHeuristic(int from, int to) const
+{
+    auto fromPosition = m_Map.getCellPosition(from);
+    auto toPosition = m_Map.getCellPosition(to);
+
+    if (m_Map.getConnectivity() == Connectivity::Eight)
+        return OctileHeuristic<GridCost>()(fromPosition, toPosition);
+
+    return ManhattanHeuristic<GridCost>()(fromPosition, toPosition);
+}
+
+bool DStarLite::buildPath()
+{
+    // Walk downhill from the start: each step goes to the neighbour that
+    // the start's cost was worked out through
+    auto cell = m_StartCell;
+    m_Path.push_back(m_Map.getCellPosition(cell));
+
+    while ((cell != m_GoalCell) && (static_cast<int>(m_Path.size()) <= m_Map.getNumCells()))
+    {
+        auto bestCell = -1;
+        auto bestCost = INFINITE_COST;
+        for (int i = 0; i < m_Map.getNumDirections(); ++i)
+        {
+            auto direction = m_Map.getDirections()[i];
+            if (!m_Map.canMove(cell, direction))
+                continue;
+
+            auto neighbor = cell + m_Map.getOffset(direction);
+            if (m_Costs[neighbor] >= INFINITE_COST)
+                continue;
+
+            auto cost = GridCost::getStepCost(direction) + m_Costs[neighbor];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestCell = neighbor;
+            }
+        }
+
+        if (bestCell == -1)
+            break;
+
+        cell = bestCell;
+        m_Path.push_back(m_Map.getCellPosition(cell));
+    }
+
+    return cell == m_GoalCell;
+}
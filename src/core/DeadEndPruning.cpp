@@ -0,0 +1,305 @@
+#include "core/DeadEndPruning.hpp"
+
+#include <algorithm>
+
+DeadEndPruning::DeadEndPruning(const GridMap& map, SearchAlgorithm algorithm)
+    : m_Map(map)
+    , m_Algorithm(algorithm)
+    , m_IsStale(true)
+    , m_NumPrunedCells(0)
+    , m_LargestBlock(-1)
+{
+    m_Map.addListener(this);
+}
+
+DeadEndPruning::~DeadEndPruning()
+{
+    m_Map.removeListener(this);
+}
+
+bool DeadEndPruning::findPath(const Point& start, const Point& goal)
+{
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    if (m_IsStale)
+        prune();
+
+    if (m_Map.isWall(start) || m_Map.isWall(goal))
+        return false;
+
+    auto startBlock = m_Blocks[m_Map.getCellIndex(start)];
+    auto goalBlock = m_Blocks[m_Map.getCellIndex(goal)];
+    if (m_Regions[startBlock] != m_Regions[goalBlock])
+        return false;
+
+    openPath(startBlock, goalBlock);
+
+    bool hasFoundPath = m_Search->findPath(start, goal);
+    m_Path = m_Search->getPath();
+    m_PathCost = m_Search->getPathCost();
+    m_NumExpansions = m_Search->getNumExpansions();
+
+    closeOpened();
+
+    return hasFoundPath;
+}
+
+void DeadEndPruning::onWallAdded(const Point&)
+{
+    m_IsStale = true;
+}
+
+void DeadEndPruning::onWallRemoved(const Point&)
+{
+    m_IsStale = true;
+}
+
+void DeadEndPruning::onMapChanged()
+{
+    m_IsStale = true;
+}
+
+int DeadEndPruning::getNumPrunedCells() const
+{
+    return m_NumPrunedCells;
+}
+
+void DeadEndPruning::prune()
+{
+    findBlocks();
+
+    // Both maps have the same size, so they share a layout
+    m_Pruned.resize(m_Map.getWidth(), m_Map.getHeight());
+    m_Pruned.setConnectivity(m_Map.getConnectivity());
+    m_Pruned.setCornerCutting(m_Map.getCornerCutting());
+
+    m_NumPrunedCells = 0;
+    for (int y = 0; y < m_Map.getHeight(); ++y)
+    {
+        for (int x = 0; x < m_Map.getWidth(); ++x)
+        {
+            auto cell = m_Map.getCellIndex({ x, y });
+            if (m_Map.isWall(cell))
+            {
+                m_Pruned.addWall({ x, y });
+            }
+            else if (m_Blocks[cell] != m_LargestBlock)
+            {
+                m_Pruned.addWall({ x, y });
+                ++m_NumPrunedCells;
+            }
+        }
+    }
+
+    // The cut cell the largest block hangs from belongs to another block
+    if (m_LargestBlock != -1)
+    {
+        auto cell = m_BlockCells[m_BlockStarts[m_LargestBlock + 1] - 1];
+        if (m_Pruned.isWall(cell))
+        {
+            m_Pruned.removeWall(m_Map.getCellPosition(cell));
+            --m_NumPrunedCells;
+        }
+    }
+
+    // Made once the rules are set, as the factory picks an engine by them
+    m_Search = PathfinderFactory::create(m_Pruned, m_Algorithm);
+    m_IsStale = false;
+}
+
+void DeadEndPruning::findBlocks()
+{
+    auto numCells = m_Map.getNumCells();
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    m_Blocks.assign(numCells, -1);
+    m_ParentBlocks.clear();
+    m_Depths.clear();
+    m_Regions.clear();
+    m_BlockStarts.assign(1, 0);
+    m_BlockCells.clear();
+
+    // Tarjan's algorithm, with an explicit stack of the cells being
+    // searched and the next direction each will try
+    struct Frame
+    {
+        int cell;
+        int direction;
+    };
+
+    std::vector<int> discovered(numCells, -1);
+    std::vector<int> lowest(numCells, 0);
+    std::vector<int> parents(numCells, -1);
+    std::vector<Frame> frames;
+    std::vector<int> stack;
+
+    int time = 0;
+    int numRegions = 0;
+    for (int y = 0; y < m_Map.getHeight(); ++y)
+    {
+        for (int x = 0; x < m_Map.getWidth(); ++x)
+        {
+            auto root = m_Map.getCellIndex({ x, y });
+            if (m_Map.isWall(root) || (discovered[root] != -1))
+                continue;
+
+            auto firstBlock = static_cast<int>(m_ParentBlocks.size());
+            discovered[root] = lowest[root] = time++;
+            stack.push_back(root);
+            frames.push_back({ root, 0 });
+
+            while (!frames.empty())
+            {
+                auto cell = frames.back().cell;
+                if (frames.back().direction < numDirections)
+                {
+                    auto direction = directions[frames.back().direction++];
+                    if (!m_Map.canMove(cell, direction))
+                        continue;
+
+                    auto neighbor = cell + m_Map.getOffset(direction);
+                    if (discovered[neighbor] == -1)
+                    {
+                        parents[neighbor] = cell;
+                        discovered[neighbor] = lowest[neighbor] = time++;
+                        stack.push_back(neighbor);
+                        frames.push_back({ neighbor, 0 });
+                    }
+                    else if (neighbor != parents[cell])
+                    {
+                        lowest[cell] = std::min(lowest[cell], discovered[neighbor]);
+                    }
+
+                    continue;
+                }
+
+                frames.pop_back();
+
+                auto parent = parents[cell];
+                if (parent == -1)
+                    continue;
+
+                lowest[parent] = std::min(lowest[parent], lowest[cell]);
+
+                // Nothing below cell reaches above parent, so parent cuts
+                // them off and they form a block with it
+                if (lowest[cell] >= discovered[parent])
+                    addBlock(parent, stack, cell);
+            }
+
+            // The root is the cut cell of every block in its region that
+            // it belongs to, unless it has no moves at all
+            if (static_cast<int>(m_ParentBlocks.size()) == firstBlock)
+            {
+                addBlock(-1, stack, root);
+            }
+            else
+            {
+                stack.pop_back();
+                m_Blocks[root] = m_ParentBlocks.size() - 1;
+            }
+
+            // Blocks are finished children first, so parents come later
+            // and are visited first here
+            auto lastBlock = static_cast<int>(m_ParentBlocks.size()) - 1;
+            m_Depths.resize(m_ParentBlocks.size());
+            for (int block = lastBlock; block >= firstBlock; --block)
+            {
+                auto topCell = m_ParentBlocks[block];
+                auto parentBlock = ((topCell == -1) || (topCell == root)) ? -1 : m_Blocks[topCell];
+
+                m_ParentBlocks[block] = parentBlock;
+                m_Depths[block] = (parentBlock == -1) ? 0 : m_Depths[parentBlock] + 1;
+                m_Regions.push_back(numRegions);
+            }
+
+            ++numRegions;
+        }
+    }
+
+    m_LargestBlock = -1;
+    int largestSize = 0;
+    for (int block = 0; block < static_cast<int>(m_ParentBlocks.size()); ++block)
+    {
+        auto size = m_BlockStarts[block + 1] - m_BlockStarts[block];
+        if (size > largestSize)
+        {
+            largestSize = size;
+            m_LargestBlock = block;
+        }
+    }
+}
+
+void DeadEndPruning::addBlock(int topCell, std::vector<int>& stack, int lastCell)
+{
+    auto block = static_cast<int>(m_ParentBlocks.size());
+
+    int cell;
+    do
+    {
+        cell = stack.back();
+        stack.pop_back();
+
+        m_Blocks[cell] = block;
+        m_BlockCells.push_back(cell);
+    }
+    while (cell != lastCell);
+
+    // Listed last, and kept in place of the parent until the tree is built
+    if (topCell != -1)
+        m_BlockCells.push_back(topCell);
+
+    m_BlockStarts.push_back(m_BlockCells.size());
+    m_ParentBlocks.push_back(topCell);
+}
+
+void DeadEndPruning::openPath(int startBlock, int goalBlock)
+{
+    auto getDepth = [&](int block)
+    {
+        return (block == -1) ? -1 : m_Depths[block];
+    };
+
+    // Climb from the deeper end until the two meet
+    while (startBlock != goalBlock)
+    {
+        if (getDepth(startBlock) >= getDepth(goalBlock))
+        {
+            openBlock(startBlock);
+            startBlock = m_ParentBlocks[startBlock];
+        }
+        else
+        {
+            openBlock(goalBlock);
+            goalBlock = m_ParentBlocks[goalBlock];
+        }
+    }
+
+    if (startBlock != -1)
+        openBlock(startBlock);
+}
+
+void DeadEndPruning::openBlock(int block)
+{
+    for (auto i = m_BlockStarts[block]; i < m_BlockStarts[block + 1]; ++i)
+    {
+        auto cell = m_BlockCells[i];
+        if (m_Pruned.isWall(cell))
+        {
+            auto position = m_Map.getCellPosition(cell);
+            m_Pruned.removeWall(position);
+            m_Opened.push_back(position);
+        }
+    }
+}
+
+void DeadEndPruning::closeOpened()
+{
+    for (auto& position : m_Opened)
+        m_Pruned.addWall(position);
+
+    m_Opened.clear();
+}
@@ -0,0 +1,270 @@
+#include "core/GridMap.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+const Direction GridMap::CARDINAL_DIRECTIONS[4] =
+{
+    Direction::North, Direction::East, Direction::South, Direction::West
+};
+
+const Direction GridMap::ALL_DIRECTIONS[8] =
+{
+    Direction::North, Direction::NorthEast, Direction::East, Direction::SouthEast,
+    Direction::South, Direction::SouthWest, Direction::West, Direction::NorthWest
+};
+
+GridMap::GridMap()
+    : m_Width(0)
+    , m_Height(0)
+    , m_Offsets()
+    , m_Revision(0)
+    , m_Connectivity(Connectivity::Four)
+    , m_CornerCutting(CornerCutting::NoSqueeze)
+{
+
+}
+
+GridMap::GridMap(int width, int height)
+    : GridMap()
+{
+    resize(width, height);
+}
+
+void GridMap::resize(int width, int height)
+{
+    m_Width = width;
+    m_Height = height;
+    m_Walls.resize(width + 2, height + 2);
+
+    updateOffsets();
+    addBorder();
+    notifyChanged();
+}
+
+void GridMap::view(int width, int height, BitGrid::Word* walls)
+{
+    m_Width = width;
+    m_Height = height;
+    m_Walls.view(width + 2, height + 2, walls);
+
+    updateOffsets();
+    notifyChanged();
+}
+
+int GridMap::getWidth() const
+{
+    return m_Width;
+}
+
+int GridMap::getHeight() const
+{
+    return m_Height;
+}
+
+int GridMap::getStride() const
+{
+    return m_Walls.getStride();
+}
+
+int GridMap::getNumCells() const
+{
+    return getStride() * (m_Height + 2);
+}
+
+bool GridMap::isInside(const Point& position) const
+{
+    return (position.x >= 0) && (position.x < m_Width)
+        && (position.y >= 0) && (position.y < m_Height);
+}
+
+bool GridMap::isWall(const Point& position) const
+{
+    return m_Walls.test(position.x + 1, position.y + 1);
+}
+
+bool GridMap::isWall(int cell) const
+{
+    return m_Walls.test(cell);
+}
+
+void GridMap::addWall(const Point& position)
+{
+    assert(isInside(position));
+
+    if (!m_Walls.test(position.x + 1, position.y + 1))
+    {
+        m_Walls.set(position.x + 1, position.y + 1);
+        ++m_Revision;
+
+        for (auto listener : m_Listeners)
+            listener->onWallAdded(position);
+    }
+}
+
+void GridMap::removeWall(const Point& position)
+{
+    assert(isInside(position));
+
+    if (m_Walls.test(position.x + 1, position.y + 1))
+    {
+        m_Walls.clear(position.x + 1, position.y + 1);
+        ++m_Revision;
+
+        for (auto listener : m_Listeners)
+            listener->onWallRemoved(position);
+    }
+}
+
+void GridMap::addWallRow(int y, int beginX, int endX)
+{
+    assert((y >= 0) && (y < m_Height) && (beginX >= 0) && (endX <= m_Width));
+
+    m_Walls.fillRow(y + 1, beginX + 1, endX + 1);
+    notifyChanged();
+}
+
+void GridMap::clearWalls()
+{
+    m_Walls.clearAll();
+    addBorder();
+    notifyChanged();
+}
+
+unsigned GridMap::getRevision() const
+{
+    return m_Revision;
+}
+
+void GridMap::addListener(MapListener* listener) const
+{
+    m_Listeners.push_back(listener);
+}
+
+void GridMap::removeListener(MapListener* listener) const
+{
+    m_Listeners.erase(std::remove(m_Listeners.begin(), m_Listeners.end(), listener), m_Listeners.end());
+}
+
+void GridMap::setConnectivity(Connectivity connectivity)
+{
+    m_Connectivity = connectivity;
+    notifyChanged();
+}
+
+Connectivity GridMap::getConnectivity() const
+{
+    return m_Connectivity;
+}
+
+void GridMap::setCornerCutting(CornerCutting cornerCutting)
+{
+    m_CornerCutting = cornerCutting;
+    notifyChanged();
+}
+
+CornerCutting GridMap::getCornerCutting() const
+{
+    return m_CornerCutting;
+}
+
+const Direction* GridMap::getDirections() const
+{
+    return (m_Connectivity == Connectivity::Eight) ? ALL_DIRECTIONS : CARDINAL_DIRECTIONS;
+}
+
+int GridMap::getNumDirections() const
+{
+    return (m_Connectivity == Connectivity::Eight) ? 8 : 4;
+}
+
+bool GridMap::canMove(int cell, Direction direction) const
+{
+    if (isWall(cell + getOffset(direction)))
+        return false;
+
+    if (!isDiagonal(direction) || (m_CornerCutting == CornerCutting::Allow))
+        return true;
+
+    // The two cardinal directions either side of a diagonal
+    auto index = static_cast<int>(direction);
+    bool firstBlocked = isWall(cell + m_Offsets[(index + 7) % 8]);
+    bool secondBlocked = isWall(cell + m_Offsets[(index + 1) % 8]);
+
+    if (m_CornerCutting == CornerCutting::NoSqueeze)
+        return !firstBlocked || !secondBlocked;
+
+    return !firstBlocked && !secondBlocked;
+}
+
+const BitGrid& GridMap::getWalls() const
+{
+    return m_Walls;
+}
+
+int GridMap::getCellIndex(const Point& position) const
+{
+    return (position.y + 1) * getStride() + (position.x + 1);
+}
+
+Point GridMap::getCellPosition(int cell) const
+{
+    return { cell % getStride() - 1, cell / getStride() - 1 };
+}
+
+int GridMap::getOffset(Direction direction) const
+{
+    return m_Offsets[static_cast<int>(direction)];
+}
+
+Point GridMap::getDelta(Direction direction)
+{
+    static const Point deltas[8] =
+    {
+        { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 },
+        { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }
+    };
+
+    return deltas[static_cast<int>(direction)];
+}
+
+bool GridMap::isDiagonal(Direction direction)
+{
+    return (static_cast<int>(direction) % 2) == 1;
+}
+
+Point GridMap::getAdjacentNode(const Point& from, Direction direction) const
+{
+    auto delta = getDelta(direction);
+
+    return { from.x + delta.x, from.y + delta.y };
+}
+
+void GridMap::updateOffsets()
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        auto delta = getDelta(static_cast<Direction>(i));
+        m_Offsets[i] = delta.y * getStride() + delta.x;
+    }
+}
+
+void GridMap::addBorder()
+{
+    m_Walls.fillRow(0, 0, m_Width + 2);
+    m_Walls.fillRow(m_Height + 1, 0, m_Width + 2);
+
+    for (int y = 1; y <= m_Height; ++y)
+    {
+        m_Walls.set(0, y);
+        m_Walls.set(m_Width + 1, y);
+    }
+}
+
+void GridMap::notifyChanged()
+{
+    ++m_Revision;
+
+    for (auto listener : m_Listeners)
+        listener->onMapChanged();
+}
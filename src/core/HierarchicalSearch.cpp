@@ -0,0 +1,527 @@
+#include "core/HierarchicalSearch.hpp"
+
+#include "core/Heuristics.hpp"
+
+#include <climits>
+
+namespace
+{
+    // Runs of free cells along a cluster edge at least this long get an
+    // entrance at each end instead of one in the middle
+    const int SPLIT_ENTRANCE_LENGTH = 6;
+}
+
+const int HierarchicalSearch::UNREACHABLE = INT_MAX;
+
+HierarchicalSearch::HierarchicalSearch(const GridMap& map, int clusterSize)
+    : m_Map(map)
+    , m_ClusterSize(clusterSize)
+    , m_IsBuilt(false)
+    , m_NumClustersX(0)
+    , m_NumClustersY(0)
+    , m_StartCell(-1)
+    , m_GoalCell(-1)
+    , m_DirectCost(UNREACHABLE)
+    , m_AbstractSpace(map)
+    , m_LocalSpace(map)
+{
+    m_Map.addListener(this);
+}
+
+HierarchicalSearch::~HierarchicalSearch()
+{
+    m_Map.removeListener(this);
+}
+
+bool HierarchicalSearch::findPath(const Point& start, const Point& goal)
+{
+    update();
+
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    m_StartCell = m_Map.getCellIndex(start);
+    m_GoalCell = m_Map.getCellIndex(goal);
+    if (m_Map.isWall(m_StartCell) || m_Map.isWall(m_GoalCell))
+        return false;
+
+    if (m_StartCell == m_GoalCell)
+    {
+        m_Path.push_back(start);
+        return true;
+    }
+
+    connectEndpoints(m_StartCell, m_GoalCell);
+    if (!searchAbstract(m_StartCell, m_GoalCell))
+        return false;
+
+    refinePath();
+
+    return true;
+}
+
+void HierarchicalSearch::onWallAdded(const Point& position)
+{
+    markDirty(position);
+}
+
+void HierarchicalSearch::onWallRemoved(const Point& position)
+{
+    markDirty(position);
+}
+
+void HierarchicalSearch::onMapChanged()
+{
+    m_IsBuilt = false;
+    m_DirtyClusters.clear();
+}
+
+int HierarchicalSearch::getNumEntrances() const
+{
+    int numEntrances = 0;
+    for (auto& cluster : m_Clusters)
+        numEntrances += cluster.entrances.size();
+
+    return numEntrances;
+}
+
+void HierarchicalSearch::build()
+{
+    m_NumClustersX = (m_Map.getWidth() + m_ClusterSize - 1) / m_ClusterSize;
+    m_NumClustersY = (m_Map.getHeight() + m_ClusterSize - 1) / m_ClusterSize;
+
+    m_Clusters.assign(m_NumClustersX * m_NumClustersY, Cluster());
+    m_EntranceIndices.assign(m_Map.getNumCells(), -1);
+    m_DirtyClusters.clear();
+
+    for (int y = 0; y < m_NumClustersY; ++y)
+    {
+        for (int x = 0; x < m_NumClustersX; ++x)
+        {
+            auto& cluster = m_Clusters[y * m_NumClustersX + x];
+            cluster.origin = { x * m_ClusterSize, y * m_ClusterSize };
+            cluster.width = std::min(m_ClusterSize, m_Map.getWidth() - cluster.origin.x);
+            cluster.height = std::min(m_ClusterSize, m_Map.getHeight() - cluster.origin.y);
+            cluster.isDirty = false;
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(m_Clusters.size()); ++i)
+        rebuildCluster(i);
+
+    m_IsBuilt = true;
+}
+
+void HierarchicalSearch::update()
+{
+    if (!m_IsBuilt)
+    {
+        build();
+        return;
+    }
+
+    for (auto clusterIndex : m_DirtyClusters)
+        rebuildCluster(clusterIndex);
+
+    m_DirtyClusters.clear();
+}
+
+void HierarchicalSearch::rebuildCluster(int clusterIndex)
+{
+    auto& cluster = m_Clusters[clusterIndex];
+    for (auto& entrance : cluster.entrances)
+        m_EntranceIndices[entrance.cell] = -1;
+
+    cluster.entrances.clear();
+    for (auto side : GridMap::CARDINAL_DIRECTIONS)
+        addEntrances(clusterIndex, side);
+
+    auto numEntrances = static_cast<int>(cluster.entrances.size());
+    cluster.distances.assign(numEntrances * numEntrances, UNREACHABLE);
+    for (int i = 0; i < numEntrances; ++i)
+    {
+        searchCluster(cluster, cluster.entrances[i].cell, -1);
+
+        for (int j = 0; j < numEntrances; ++j)
+        {
+            auto cell = cluster.entrances[j].cell;
+            if (m_LocalSpace.getState(cell) == CellState::Closed)
+                cluster.distances[i * numEntrances + j] = m_LocalSpace.getNode(cell).movementCost;
+        }
+    }
+
+    cluster.isDirty = false;
+}
+
+void HierarchicalSearch::addEntrances(int clusterIndex, Direction side)
+{
+    auto& cluster = m_Clusters[clusterIndex];
+    auto delta = GridMap::getDelta(side);
+
+    // The first cell of the edge facing side, the step along it and its
+    // length. Both clusters sharing an edge walk it the same way, so they
+    // agree on where its entrances are.
+    Point first = cluster.origin;
+    Point along = { 0, 1 };
+    auto length = cluster.height;
+    if (side == Direction::East)
+        first.x += cluster.width - 1;
+    else if (side == Direction::South)
+        first.y += cluster.height - 1;
+
+    if (delta.y != 0)
+    {
+        along = { 1, 0 };
+        length = cluster.width;
+    }
+
+    if (!m_Map.isInside(m_Map.getAdjacentNode(first, side)))
+        return;
+
+    auto addTransition = [&](int step, Direction direction)
+    {
+        Point position = { first.x + along.x * step, first.y + along.y * step };
+        auto cell = m_Map.getCellIndex(position);
+        Edge partner = { cell + m_Map.getOffset(direction), GridCost::getStepCost(direction) };
+
+        auto& index = m_EntranceIndices[cell];
+        if (index == -1)
+        {
+            index = cluster.entrances.size();
+            cluster.entrances.push_back({ cell, {} });
+        }
+
+        // A corner squeeze is found from both edges at the corner
+        auto& partners = cluster.entrances[index].partners;
+        for (auto& existing : partners)
+        {
+            if (existing.cell == partner.cell)
+                return;
+        }
+
+        partners.push_back(partner);
+    };
+
+    int runStart = -1;
+    for (int step = 0; step <= length; ++step)
+    {
+        bool isOpen = false;
+        if (step < length)
+        {
+            auto cell = m_Map.getCellIndex({ first.x + along.x * step, first.y + along.y * step });
+            isOpen = !m_Map.isWall(cell) && !m_Map.isWall(cell + m_Map.getOffset(side));
+
+            // Straight runs already connect every other diagonal step
+            // across the edge
+            if (!isOpen && !m_Map.isWall(cell) && (m_Map.getConnectivity() == Connectivity::Eight))
+            {
+                for (auto direction : GridMap::ALL_DIRECTIONS)
+                {
+                    auto diagonalDelta = GridMap::getDelta(direction);
+                    bool crossesSide = GridMap::isDiagonal(direction)
+                        && (diagonalDelta.x * delta.x + diagonalDelta.y * delta.y > 0);
+                    if (!crossesSide || !m_Map.canMove(cell, direction))
+                        continue;
+
+                    auto beside = cell + m_Map.getOffset(direction) - m_Map.getOffset(side);
+                    if (m_Map.isWall(beside))
+                        addTransition(step, direction);
+                }
+            }
+        }
+
+        if (isOpen && (runStart == -1))
+        {
+            runStart = step;
+        }
+        else if (!isOpen && (runStart != -1))
+        {
+            auto runLength = step - runStart;
+            if (runLength < SPLIT_ENTRANCE_LENGTH)
+            {
+                addTransition(runStart + (runLength - 1) / 2, side);
+            }
+            else
+            {
+                addTransition(runStart, side);
+                addTransition(step - 1, side);
+            }
+
+            runStart = -1;
+        }
+    }
+}
+
+int HierarchicalSearch::getClusterIndex(const Point& position) const
+{
+    return (position.y / m_ClusterSize) * m_NumClustersX + position.x / m_ClusterSize;
+}
+
+void HierarchicalSearch::markDirty(const Point& position)
+{
+    if (!m_IsBuilt)
+        return;
+
+    auto mark = [&](const Point& cellPosition)
+    {
+        auto& cluster = m_Clusters[getClusterIndex(cellPosition)];
+        if (!cluster.isDirty)
+        {
+            cluster.isDirty = true;
+            m_DirtyClusters.push_back(getClusterIndex(cellPosition));
+        }
+    };
+
+    mark(position);
+
+    // A cell on a cluster's edge can change the entrances on that edge,
+    // which the cluster across it shares, and a corner squeeze links
+    // clusters that only touch diagonally
+    for (auto direction : GridMap::ALL_DIRECTIONS)
+    {
+        auto across = m_Map.getAdjacentNode(position, direction);
+        if (m_Map.isInside(across) && (getClusterIndex(across) != getClusterIndex(position)))
+            mark(across);
+    }
+}
+
+bool HierarchicalSearch::isInCluster(const Cluster& cluster, const Point& position) const
+{
+    return (position.x >= cluster.origin.x) && (position.x < cluster.origin.x + cluster.width)
+        && (position.y >= cluster.origin.y) && (position.y < cluster.origin.y + cluster.height);
+}
+
+void HierarchicalSearch::connectEndpoints(int startCell, int goalCell)
+{
+    auto& startCluster = m_Clusters[getClusterIndex(m_Map.getCellPosition(startCell))];
+    auto& goalCluster = m_Clusters[getClusterIndex(m_Map.getCellPosition(goalCell))];
+
+    searchCluster(startCluster, startCell, -1);
+
+    m_StartEdges.clear();
+    for (auto& entrance : startCluster.entrances)
+    {
+        if ((entrance.cell != startCell) && (m_LocalSpace.getState(entrance.cell) == CellState::Closed))
+            m_StartEdges.push_back({ entrance.cell, m_LocalSpace.getNode(entrance.cell).movementCost });
+    }
+
+    m_DirectCost = UNREACHABLE;
+    if ((&startCluster == &goalCluster) && (m_LocalSpace.getState(goalCell) == CellState::Closed))
+        m_DirectCost = m_LocalSpace.getNode(goalCell).movementCost;
+
+    // Moves are symmetric, so a search out from the goal gives the costs
+    // of reaching it
+    searchCluster(goalCluster, goalCell, -1);
+
+    m_GoalCosts.assign(goalCluster.entrances.size(), UNREACHABLE);
+    for (int i = 0; i < static_cast<int>(goalCluster.entrances.size()); ++i)
+    {
+        auto cell = goalCluster.entrances[i].cell;
+        if (m_LocalSpace.getState(cell) == CellState::Closed)
+            m_GoalCosts[i] = m_LocalSpace.getNode(cell).movementCost;
+    }
+}
+
+void HierarchicalSearch::getEdges(int cell, std::vector<Edge>& edges) const
+{
+    edges.clear();
+
+    auto clusterIndex = getClusterIndex(m_Map.getCellPosition(cell));
+    auto& cluster = m_Clusters[clusterIndex];
+    auto entranceIndex = m_EntranceIndices[cell];
+
+    if (cell == m_StartCell)
+    {
+        edges = m_StartEdges;
+        if (m_DirectCost != UNREACHABLE)
+            edges.push_back({ m_GoalCell, m_DirectCost });
+    }
+    else if (entranceIndex != -1)
+    {
+        auto numEntrances = static_cast<int>(cluster.entrances.size());
+        for (int i = 0; i < numEntrances; ++i)
+        {
+            auto distance = cluster.distances[entranceIndex * numEntrances + i];
+            if ((i != entranceIndex) && (distance != UNREACHABLE))
+                edges.push_back({ cluster.entrances[i].cell, distance });
+        }
+
+        if (clusterIndex == getClusterIndex(m_Map.getCellPosition(m_GoalCell)))
+        {
+            auto goalCost = m_GoalCosts[entranceIndex];
+            if (goalCost != UNREACHABLE)
+                edges.push_back({ m_GoalCell, goalCost });
+        }
+    }
+
+    if (entranceIndex != -1)
+    {
+        auto& partners = cluster.entrances[entranceIndex].partners;
+        edges.insert(edges.end(), partners.begin(), partners.end());
+    }
+}
+
+bool HierarchicalSearch::searchAbstract(int startCell, int goalCell)
+{
+    m_AbstractSpace.prepare();
+    if (m_AbstractOpenSet.getCapacity() != m_Map.getNumCells())
+        m_AbstractOpenSet.resize(m_Map.getNumCells());
+
+    m_AbstractOpenSet.clear();
+
+    auto& startNode = m_AbstractSpace.getNode(startCell);
+    startNode.parent = -1;
+    startNode.movementCost = 0;
+    m_AbstractSpace.setState(startCell, CellState::Open);
+    m_AbstractOpenSet.push(startCell, { getHeuristic(startCell, goalCell), 0 });
+
+    while (!m_AbstractOpenSet.isEmpty())
+    {
+        auto currentCell = m_AbstractOpenSet.pop();
+        auto& currentNode = m_AbstractSpace.getNode(currentCell);
+        if (currentCell == goalCell)
+        {
+            m_PathCost = currentNode.movementCost;
+            return true;
+        }
+
+        m_AbstractSpace.setState(currentCell, CellState::Closed);
+        ++m_NumExpansions;
+
+        getEdges(currentCell, m_Edges);
+        for (auto& edge : m_Edges)
+        {
+            auto neighborState = m_AbstractSpace.getState(edge.cell);
+            if (neighborState == CellState::Closed)
+                continue;
+
+            auto tentativeMovementCost = currentNode.movementCost + edge.cost;
+
+            bool neighborInOpenSet = (neighborState == CellState::Open);
+            auto& neighborNode = m_AbstractSpace.getNode(edge.cell);
+            if (!neighborInOpenSet || (tentativeMovementCost < neighborNode.movementCost))
+            {
+                neighborNode.parent = currentCell;
+                neighborNode.movementCost = tentativeMovementCost;
+
+                SearchKey key = { tentativeMovementCost + getHeuristic(edge.cell, goalCell),
+                                  tentativeMovementCost };
+                if (neighborInOpenSet)
+                {
+                    m_AbstractOpenSet.decreaseKey(edge.cell, key);
+                }
+                else
+                {
+                    m_AbstractOpenSet.push(edge.cell, key);
+                    m_AbstractSpace.setState(edge.cell, CellState::Open);
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool HierarchicalSearch::searchCluster(const Cluster& cluster, int startCell, int goalCell)
+{
+    m_LocalSpace.prepare();
+    if (m_LocalOpenSet.getCapacity() != m_Map.getNumCells())
+        m_LocalOpenSet.resize(m_Map.getNumCells());
+
+    m_LocalOpenSet.clear();
+
+    auto& startNode = m_LocalSpace.getNode(startCell);
+    startNode.parent = -1;
+    startNode.movementCost = 0;
+    m_LocalSpace.setState(startCell, CellState::Open);
+    m_LocalOpenSet.push(startCell, { (goalCell == -1) ? 0 : getHeuristic(startCell, goalCell), 0 });
+
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    while (!m_LocalOpenSet.isEmpty())
+    {
+        auto currentCell = m_LocalOpenSet.pop();
+        auto& currentNode = m_LocalSpace.getNode(currentCell);
+        m_LocalSpace.setState(currentCell, CellState::Closed);
+        if (currentCell == goalCell)
+            return true;
+
+        ++m_NumExpansions;
+
+        auto currentPosition = m_Map.getCellPosition(currentCell);
+        for (int i = 0; i < numDirections; ++i)
+        {
+            auto direction = directions[i];
+            if (!m_Map.canMove(currentCell, direction)
+                || !isInCluster(cluster, m_Map.getAdjacentNode(currentPosition, direction)))
+                continue;
+
+            auto neighborCell = currentCell + m_Map.getOffset(direction);
+            auto neighborState = m_LocalSpace.getState(neighborCell);
+            if (neighborState == CellState::Closed)
+                continue;
+
+            auto tentativeMovementCost = currentNode.movementCost + GridCost::getStepCost(direction);
+
+            bool neighborInOpenSet = (neighborState == CellState::Open);
+            auto& neighborNode = m_LocalSpace.getNode(neighborCell);
+            if (!neighborInOpenSet || (tentativeMovementCost < neighborNode.movementCost))
+            {
+                neighborNode.parent = currentCell;
+                neighborNode.movementCost = tentativeMovementCost;
+
+                auto heuristic = (goalCell == -1) ? 0 : getHeuristic(neighborCell, goalCell);
+                SearchKey key = { tentativeMovementCost + heuristic, tentativeMovementCost };
+                if (neighborInOpenSet)
+                {
+                    m_LocalOpenSet.decreaseKey(neighborCell, key);
+                }
+                else
+                {
+                    m_LocalOpenSet.push(neighborCell, key);
+                    m_LocalSpace.setState(neighborCell, CellState::Open);
+                }
+            }
+        }
+    }
+
+    return goalCell == -1;
+}
+
+void HierarchicalSearch::refinePath()
+{
+    m_AbstractSpace.buildPath(m_GoalCell, m_AbstractPath);
+    m_Path.push_back(m_AbstractPath.front());
+
+    for (std::size_t i = 1; i < m_AbstractPath.size(); ++i)
+    {
+        auto& from = m_AbstractPath[i - 1];
+        auto& to = m_AbstractPath[i];
+
+        // Steps between clusters are a single move through an entrance;
+        // steps inside one are filled in by searching just that cluster
+        auto clusterIndex = getClusterIndex(from);
+        if (clusterIndex != getClusterIndex(to))
+        {
+            m_Path.push_back(to);
+            continue;
+        }
+
+        searchCluster(m_Clusters[clusterIndex], m_Map.getCellIndex(from), m_Map.getCellIndex(to));
+        m_LocalSpace.buildPath(m_Map.getCellIndex(to), m_Segment);
+        m_Path.insert(m_Path.end(), m_Segment.begin() + 1, m_Segment.end());
+    }
+}
+
+int HierarchicalSearch::getHeuristic(int from, int to) const
+{
+    auto fromPosition = m_Map.getCellPosition(from);
+    auto toPosition = m_Map.getCellPosition(to);
+
+    if (m_Map.getConnectivity() == Connectivity::Eight)
+        return OctileHeuristic<GridCost>()(fromPosition, toPosition);
+
+    return ManhattanHeuristic<GridCost>()(fromPosition, toPosition);
+}
@@ -0,0 +1,424 @@
+#include "core/JumpPointSearch.hpp"
+
+#include "core/Heuristics.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    int getSign(int value)
+    {
+        return (value > 0) - (value < 0);
+    }
+
+    Direction toDirection(int deltaX, int deltaY)
+    {
+        static const Direction directions[3][3] =
+        {
+            { Direction::NorthWest, Direction::North, Direction::NorthEast },
+            { Direction::West, Direction::North, Direction::East },
+            { Direction::SouthWest, Direction::South, Direction::SouthEast }
+        };
+
+        return directions[deltaY + 1][deltaX + 1];
+    }
+}
+
+JumpPointSearch::JumpPointSearch(const GridMap& map, bool usePrecomputedJumps)
+    : m_Map(map)
+    , m_Space(map)
+    , m_UsePrecomputedJumps(usePrecomputedJumps)
+    , m_JumpRevision(0)
+    , m_HasJumps(false)
+{
+
+}
+
+bool JumpPointSearch::isSupported(const GridMap& map)
+{
+    return (map.getConnectivity() == Connectivity::Four)
+        || (map.getCornerCutting() == CornerCutting::Never);
+}
+
+bool JumpPointSearch::findPath(const Point& start, const Point& goal)
+{
+    prepare();
+
+    auto startCell = m_Map.getCellIndex(start);
+    auto goalCell = m_Map.getCellIndex(goal);
+    if (m_Map.isWall(startCell) || m_Map.isWall(goalCell))
+        return false;
+
+    auto& startNode = m_Space.getNode(startCell);
+    startNode.parent = -1;
+    startNode.movementCost = 0;
+    m_Space.setState(startCell, CellState::Open);
+    m_OpenSet.push(startCell, { getHeuristic(start, goal), 0 });
+
+    Direction directions[8];
+    while (!m_OpenSet.isEmpty())
+    {
+        auto currentCell = m_OpenSet.pop();
+        auto& currentNode = m_Space.getNode(currentCell);
+        if (currentCell == goalCell)
+        {
+            m_PathCost = currentNode.movementCost;
+            m_Space.buildPath(currentCell, m_JumpPoints);
+            expandPath();
+            return true;
+        }
+
+        m_Space.setState(currentCell, CellState::Closed);
+        ++m_NumExpansions;
+
+        auto currentPosition = m_Map.getCellPosition(currentCell);
+        auto numDirections = findDirections(currentCell, directions);
+        for (int i = 0; i < numDirections; ++i)
+        {
+            auto jumpCell = jump(currentCell, directions[i], goalCell);
+            if (jumpCell == -1)
+                continue;
+
+            auto jumpState = m_Space.getState(jumpCell);
+            if (jumpState == CellState::Closed)
+                continue;
+
+            // Jump points always lie on a straight or diagonal line from
+            // the cell they were found from, so the octile distance is
+            // exactly the cost of the steps in between
+            auto jumpPosition = m_Map.getCellPosition(jumpCell);
+            auto tentativeMovementCost = currentNode.movementCost
+                + OctileHeuristic<GridCost>()(currentPosition, jumpPosition);
+
+            bool jumpInOpenSet = (jumpState == CellState::Open);
+            auto& jumpNode = m_Space.getNode(jumpCell);
+            if (!jumpInOpenSet || (tentativeMovementCost < jumpNode.movementCost))
+            {
+                jumpNode.parent = currentCell;
+                jumpNode.movementCost = tentativeMovementCost;
+
+                SearchKey key = { tentativeMovementCost + getHeuristic(jumpPosition, goal),
+                                  tentativeMovementCost };
+                if (jumpInOpenSet)
+                {
+                    m_OpenSet.decreaseKey(jumpCell, key);
+                }
+                else
+                {
+                    m_OpenSet.push(jumpCell, key);
+                    m_Space.setState(jumpCell, CellState::Open);
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void JumpPointSearch::prepare()
+{
+    m_Space.prepare();
+
+    if (m_OpenSet.getCapacity() != m_Map.getNumCells())
+        m_OpenSet.resize(m_Map.getNumCells());
+
+    m_OpenSet.clear();
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    if (m_UsePrecomputedJumps && (!m_HasJumps || (m_JumpRevision != m_Map.getRevision())))
+        precomputeJumps();
+}
+
+int JumpPointSearch::findDirections(int cell, Direction* directions) const
+{
+    auto parent = m_Space.getNode(cell).parent;
+    bool eightConnected = (m_Map.getConnectivity() == Connectivity::Eight);
+
+    // The start has no direction to prune by
+    if (parent == -1)
+    {
+        int numDirections = 0;
+        for (int i = 0; i < m_Map.getNumDirections(); ++i)
+        {
+            auto direction = m_Map.getDirections()[i];
+            if (m_Map.canMove(cell, direction))
+                directions[numDirections++] = direction;
+        }
+
+        return numDirections;
+    }
+
+    auto position = m_Map.getCellPosition(cell);
+    auto parentPosition = m_Map.getCellPosition(parent);
+    auto deltaX = getSign(position.x - parentPosition.x);
+    auto deltaY = getSign(position.y - parentPosition.y);
+    auto stride = m_Map.getStride();
+
+    // Directions are listed optimistically; jump rejects any that are
+    // blocked on their first step
+    int numDirections = 0;
+    if ((deltaX != 0) && (deltaY != 0))
+    {
+        directions[numDirections++] = toDirection(deltaX, 0);
+        directions[numDirections++] = toDirection(0, deltaY);
+        directions[numDirections++] = toDirection(deltaX, deltaY);
+    }
+    else if (deltaX != 0)
+    {
+        directions[numDirections++] = toDirection(deltaX, 0);
+        directions[numDirections++] = Direction::North;
+        directions[numDirections++] = Direction::South;
+
+        if (eightConnected)
+        {
+            if (isFree(cell - stride))
+                directions[numDirections++] = toDirection(deltaX, -1);
+            if (isFree(cell + stride))
+                directions[numDirections++] = toDirection(deltaX, 1);
+        }
+    }
+    else
+    {
+        directions[numDirections++] = toDirection(0, deltaY);
+        directions[numDirections++] = Direction::West;
+        directions[numDirections++] = Direction::East;
+
+        if (eightConnected)
+        {
+            if (isFree(cell - 1))
+                directions[numDirections++] = toDirection(-1, deltaY);
+            if (isFree(cell + 1))
+                directions[numDirections++] = toDirection(1, deltaY);
+        }
+    }
+
+    return numDirections;
+}
+
+int JumpPointSearch::jump(int cell, Direction direction, int goalCell) const
+{
+    if (m_UsePrecomputedJumps)
+        return jumpPrecomputed(cell, direction, goalCell);
+
+    auto delta = GridMap::getDelta(direction);
+    if (!GridMap::isDiagonal(direction))
+        return jumpStraight(cell, delta.x, delta.y, goalCell);
+
+    // A diagonal scan stops wherever one of its two straight scans finds
+    // a jump point, since an optimal path may turn there
+    auto offsetX = delta.x;
+    auto offsetY = delta.y * m_Map.getStride();
+    while (true)
+    {
+        if (!isFree(cell + offsetX) || !isFree(cell + offsetY) || !isFree(cell + offsetX + offsetY))
+            return -1;
+
+        cell += offsetX + offsetY;
+        if (cell == goalCell)
+            return cell;
+
+        if ((jumpStraight(cell, delta.x, 0, goalCell) != -1) || (jumpStraight(cell, 0, delta.y, goalCell) != -1))
+            return cell;
+    }
+}
+
+int JumpPointSearch::jumpStraight(int cell, int deltaX, int deltaY, int goalCell) const
+{
+    // On 4-connected maps the vertical scans play the part diagonal ones
+    // do on 8-connected maps
+    bool scanSideways = (deltaY != 0) && (m_Map.getConnectivity() == Connectivity::Four);
+
+    auto offset = deltaY * m_Map.getStride() + deltaX;
+    while (true)
+    {
+        cell += offset;
+        if (!isFree(cell))
+            return -1;
+
+        if ((cell == goalCell) || isForced(cell, deltaX, deltaY))
+            return cell;
+
+        if (scanSideways && ((jumpStraight(cell, 1, 0, goalCell) != -1) || (jumpStraight(cell, -1, 0, goalCell) != -1)))
+            return cell;
+    }
+}
+
+int JumpPointSearch::jumpPrecomputed(int cell, Direction direction, int goalCell) const
+{
+    auto distance = getJumpDistance(cell, direction);
+    auto freeSteps = std::abs(distance);
+    auto delta = GridMap::getDelta(direction);
+    auto offset = m_Map.getOffset(direction);
+
+    // The table knows nothing about the goal, so stop for it when it is
+    // in reach: on the line itself, or for a diagonal (or a vertical on a
+    // 4-connected map) on the row or column the goal can be scanned from
+    auto position = m_Map.getCellPosition(cell);
+    auto goal = m_Map.getCellPosition(goalCell);
+    auto goalDeltaX = goal.x - position.x;
+    auto goalDeltaY = goal.y - position.y;
+
+    if (GridMap::isDiagonal(direction))
+    {
+        if ((getSign(goalDeltaX) == delta.x) && (getSign(goalDeltaY) == delta.y))
+        {
+            auto steps = std::min(std::abs(goalDeltaX), std::abs(goalDeltaY));
+            if (steps <= freeSteps)
+                return cell + steps * offset;
+        }
+    }
+    else if (delta.x != 0)
+    {
+        if ((goalDeltaY == 0) && (getSign(goalDeltaX) == delta.x) && (std::abs(goalDeltaX) <= freeSteps))
+            return goalCell;
+    }
+    else if (m_Map.getConnectivity() == Connectivity::Four)
+    {
+        if ((getSign(goalDeltaY) == delta.y) && (std::abs(goalDeltaY) <= freeSteps))
+            return cell + std::abs(goalDeltaY) * offset;
+    }
+    else
+    {
+        if ((goalDeltaX == 0) && (getSign(goalDeltaY) == delta.y) && (std::abs(goalDeltaY) <= freeSteps))
+            return goalCell;
+    }
+
+    return (distance > 0) ? cell + distance * offset : -1;
+}
+
+bool JumpPointSearch::isForced(int cell, int deltaX, int deltaY) const
+{
+    // A side cell is open here but was blocked one step back, so the only
+    // way around that wall goes through this cell
+    auto stride = m_Map.getStride();
+    if (deltaX != 0)
+    {
+        return (isFree(cell - stride) && !isFree(cell - deltaX - stride))
+            || (isFree(cell + stride) && !isFree(cell - deltaX + stride));
+    }
+
+    return (isFree(cell - 1) && !isFree(cell - 1 - deltaY * stride))
+        || (isFree(cell + 1) && !isFree(cell + 1 - deltaY * stride));
+}
+
+bool JumpPointSearch::isFree(int cell) const
+{
+    return !m_Map.isWall(cell);
+}
+
+void JumpPointSearch::precomputeJumps()
+{
+    m_JumpDistances.assign(static_cast<std::size_t>(m_Map.getNumCells()) * 8, 0);
+
+    // Horizontal scans first, then vertical and diagonal ones, which stop
+    // where a horizontal (and vertical) scan finds a jump point
+    static const Direction order[8] =
+    {
+        Direction::East, Direction::West, Direction::North, Direction::South,
+        Direction::NorthEast, Direction::SouthEast, Direction::SouthWest, Direction::NorthWest
+    };
+
+    bool eightConnected = (m_Map.getConnectivity() == Connectivity::Eight);
+    auto stride = m_Map.getStride();
+    for (auto direction : order)
+    {
+        auto delta = GridMap::getDelta(direction);
+        auto offset = m_Map.getOffset(direction);
+
+        // Visit cells so the next one along direction is always done
+        // first, then extend its distance by one step
+        for (int i = 0; i < m_Map.getHeight(); ++i)
+        {
+            auto y = (delta.y > 0) ? m_Map.getHeight() - 1 - i : i;
+            for (int j = 0; j < m_Map.getWidth(); ++j)
+            {
+                auto x = (delta.x > 0) ? m_Map.getWidth() - 1 - j : j;
+                auto cell = m_Map.getCellIndex({ x, y });
+                if (!isFree(cell))
+                    continue;
+
+                auto next = cell + offset;
+                bool canStep = isFree(next);
+                if (GridMap::isDiagonal(direction))
+                    canStep = canStep && isFree(cell + delta.x) && isFree(cell + delta.y * stride);
+
+                if (!canStep)
+                    continue;
+
+                bool isJumpPoint;
+                if (GridMap::isDiagonal(direction))
+                {
+                    isJumpPoint = (getJumpDistance(next, toDirection(delta.x, 0)) > 0)
+                        || (getJumpDistance(next, toDirection(0, delta.y)) > 0);
+                }
+                else
+                {
+                    isJumpPoint = isForced(next, delta.x, delta.y);
+                    if (!eightConnected && (delta.y != 0))
+                    {
+                        isJumpPoint = isJumpPoint
+                            || (getJumpDistance(next, Direction::East) > 0)
+                            || (getJumpDistance(next, Direction::West) > 0);
+                    }
+                }
+
+                auto nextDistance = getJumpDistance(next, direction);
+                if (isJumpPoint)
+                    getJumpDistance(cell, direction) = 1;
+                else
+                    getJumpDistance(cell, direction) = (nextDistance > 0) ? nextDistance + 1 : nextDistance - 1;
+            }
+        }
+
+        if (!eightConnected && (direction == Direction::South))
+            break;
+    }
+
+    m_JumpRevision = m_Map.getRevision();
+    m_HasJumps = true;
+}
+
+int& JumpPointSearch::getJumpDistance(int cell, Direction direction)
+{
+    return m_JumpDistances[static_cast<std::size_t>(cell) * 8 + static_cast<int>(direction)];
+}
+
+int JumpPointSearch::getJumpDistance(int cell, Direction direction) const
+{
+    return m_JumpDistances[static_cast<std::size_t>(cell) * 8 + static_cast<int>(direction)];
+}
+
+int JumpPointSearch::getHeuristic(const Point& from, const Point& to) const
+{
+    if (m_Map.getConnectivity() == Connectivity::Eight)
+        return OctileHeuristic<GridCost>()(from, to);
+
+    return ManhattanHeuristic<GridCost>()(from, to);
+}
+
+void JumpPointSearch::expandPath()
+{
+    m_Path.clear();
+    if (m_JumpPoints.empty())
+        return;
+
+    auto current = m_JumpPoints.front();
+    m_Path.push_back(current);
+
+    for (std::size_t i = 1; i < m_JumpPoints.size(); ++i)
+    {
+        auto next = m_JumpPoints[i];
+        auto stepX = getSign(next.x - current.x);
+        auto stepY = getSign(next.y - current.y);
+
+        while (current != next)
+        {
+            current.x += stepX;
+            current.y += stepY;
+            m_Path.push_back(current);
+        }
+    }
+}
@@ -0,0 +1,225 @@
+#include "core/LandmarkTable.hpp"
+
+#include <climits>
+#include <limits>
+
+const std::int32_t LandmarkTable::UNREACHABLE_EXACT = -1;
+const std::uint16_t LandmarkTable::UNREACHABLE_QUANTIZED = std::numeric_limits<std::uint16_t>::max();
+
+LandmarkTable::LandmarkTable(const GridMap& map, int numLandmarks, LandmarkStorage storage, std::size_t memoryBudget)
+    : m_Map(map)
+    , m_RequestedLandmarks(numLandmarks)
+    , m_Storage(storage)
+    , m_MemoryBudget(memoryBudget)
+    , m_NumLandmarks(0)
+    , m_Revision(0)
+    , m_IsBuilt(false)
+    , m_Unit(1)
+    , m_IsLossless(true)
+{
+
+}
+
+void LandmarkTable::build()
+{
+    auto numCells = m_Map.getNumCells();
+    m_NumLandmarks = chooseNumLandmarks();
+    m_Landmarks.clear();
+    m_ExactDistances.assign(static_cast<std::size_t>(numCells) * m_NumLandmarks, UNREACHABLE_EXACT);
+    m_QuantizedDistances.clear();
+    m_Distances.assign(numCells, INT_MAX);
+
+    if (m_OpenSet.getCapacity() != numCells)
+        m_OpenSet.resize(numCells);
+
+    // Distance from each cell to its nearest landmark so far
+    std::vector<int> nearest(numCells, INT_MAX);
+
+    // The first landmark is the cell farthest from an arbitrary one, which
+    // lands on the edge of the map rather than in the middle
+    int next = -1;
+    for (int y = 0; (y < m_Map.getHeight()) && (next == -1); ++y)
+    {
+        for (int x = 0; (x < m_Map.getWidth()) && (next == -1); ++x)
+        {
+            if (!m_Map.isWall({ x, y }))
+                next = m_Map.getCellIndex({ x, y });
+        }
+    }
+
+    if ((next != -1) && (m_NumLandmarks > 0))
+    {
+        auto longest = runDijkstra(next);
+        for (int cell = 0; cell < numCells; ++cell)
+        {
+            if (m_Distances[cell] == longest)
+            {
+                next = cell;
+                break;
+            }
+        }
+    }
+
+    int longestDistance = 0;
+    while ((next != -1) && (static_cast<int>(m_Landmarks.size()) < m_NumLandmarks))
+    {
+        auto landmark = static_cast<int>(m_Landmarks.size());
+        m_Landmarks.push_back(m_Map.getCellPosition(next));
+        longestDistance = std::max(longestDistance, runDijkstra(next));
+
+        next = -1;
+        int farthest = 0;
+        for (int y = 0; y < m_Map.getHeight(); ++y)
+        {
+            for (int x = 0; x < m_Map.getWidth(); ++x)
+            {
+                auto cell = m_Map.getCellIndex({ x, y });
+                if (m_Map.isWall(cell))
+                    continue;
+
+                auto distance = m_Distances[cell];
+                if (distance != INT_MAX)
+                    m_ExactDistances[cell * m_NumLandmarks + landmark] = distance;
+
+                nearest[cell] = std::min(nearest[cell], distance);
+                if (nearest[cell] > farthest)
+                {
+                    farthest = nearest[cell];
+                    next = cell;
+                }
+            }
+        }
+    }
+
+    // A map with fewer free cells than landmarks runs out early
+    if (static_cast<int>(m_Landmarks.size()) < m_NumLandmarks)
+    {
+        auto numLandmarks = static_cast<int>(m_Landmarks.size());
+        std::vector<std::int32_t> distances(static_cast<std::size_t>(numCells) * numLandmarks);
+        for (int cell = 0; cell < numCells; ++cell)
+        {
+            for (int i = 0; i < numLandmarks; ++i)
+                distances[cell * numLandmarks + i] = m_ExactDistances[cell * m_NumLandmarks + i];
+        }
+
+        m_ExactDistances.swap(distances);
+        m_NumLandmarks = numLandmarks;
+    }
+
+    if (m_Storage == LandmarkStorage::Quantized)
+        quantize(longestDistance);
+
+    // Only the table counts against the memory budget
+    std::vector<int>().swap(m_Distances);
+    m_OpenSet.resize(0);
+
+    m_Revision = m_Map.getRevision();
+    m_IsBuilt = true;
+}
+
+bool LandmarkTable::isLossless() const
+{
+    return m_IsLossless;
+}
+
+int LandmarkTable::getNumLandmarks() const
+{
+    return m_NumLandmarks;
+}
+
+const std::vector<Point>& LandmarkTable::getLandmarks() const
+{
+    return m_Landmarks;
+}
+
+std::size_t LandmarkTable::getMemoryUsage() const
+{
+    return m_ExactDistances.size() * sizeof(std::int32_t) + m_QuantizedDistances.size() * sizeof(std::uint16_t);
+}
+
+int LandmarkTable::chooseNumLandmarks() const
+{
+    if (m_MemoryBudget == 0)
+        return m_RequestedLandmarks;
+
+    auto entrySize = (m_Storage == LandmarkStorage::Exact) ? sizeof(std::int32_t) : sizeof(std::uint16_t);
+    auto landmarkSize = static_cast<std::size_t>(m_Map.getNumCells()) * entrySize;
+
+    return static_cast<int>(std::min<std::size_t>(m_RequestedLandmarks, m_MemoryBudget / landmarkSize));
+}
+
+int LandmarkTable::runDijkstra(int sourceCell)
+{
+    std::fill(m_Distances.begin(), m_Distances.end(), INT_MAX);
+    m_OpenSet.clear();
+
+    m_Distances[sourceCell] = 0;
+    m_OpenSet.push(sourceCell, 0);
+
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    int longest = 0;
+    while (!m_OpenSet.isEmpty())
+    {
+        auto cell = m_OpenSet.pop();
+        auto distance = m_Distances[cell];
+        longest = distance;
+
+        for (int i = 0; i < numDirections; ++i)
+        {
+            auto direction = directions[i];
+            if (!m_Map.canMove(cell, direction))
+                continue;
+
+            auto neighbor = cell + m_Map.getOffset(direction);
+            auto neighborDistance = distance + GridCost::getStepCost(direction);
+            if (neighborDistance >= m_Distances[neighbor])
+                continue;
+
+            if (m_Distances[neighbor] == INT_MAX)
+                m_OpenSet.push(neighbor, neighborDistance);
+            else
+                m_OpenSet.decreaseKey(neighbor, neighborDistance);
+
+            m_Distances[neighbor] = neighborDistance;
+        }
+    }
+
+    return longest;
+}
+
+void LandmarkTable::quantize(int longestDistance)
+{
+    // Every path cost is a sum of step costs, so a multiple of their
+    // greatest common divisor
+    auto granularity = static_cast<int>(GridCost::STRAIGHT);
+    if (m_Map.getConnectivity() == Connectivity::Eight)
+    {
+        auto other = static_cast<int>(GridCost::DIAGONAL);
+        while (other != 0)
+        {
+            auto remainder = granularity % other;
+            granularity = other;
+            other = remainder;
+        }
+    }
+
+    // The largest entry is reserved for unreachable cells
+    auto maxEntry = static_cast<int>(UNREACHABLE_QUANTIZED) - 1;
+    auto unitsPerEntry = (longestDistance / granularity + maxEntry - 1) / maxEntry;
+    m_Unit = granularity * std::max(1, unitsPerEntry);
+    m_IsLossless = (m_Unit == granularity);
+
+    m_QuantizedDistances.resize(m_ExactDistances.size());
+    for (std::size_t i = 0; i < m_ExactDistances.size(); ++i)
+    {
+        auto distance = m_ExactDistances[i];
+        m_QuantizedDistances[i] = (distance == UNREACHABLE_EXACT)
+            ? UNREACHABLE_QUANTIZED
+            : static_cast<std::uint16_t>(distance / m_Unit);
+    }
+
+    // The exact table was only needed to find the unit
+    std::vector<std::int32_t>().swap(m_ExactDistances);
+}
@@ -0,0 +1,167 @@
+#include "core/MapFile.hpp"
+
+#include <cstdint>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    const std::uint32_t MAGIC = 0x50414D47; // "GMAP"
+    const std::uint32_t VERSION = 1;
+
+    // 32 bytes, so the words after it stay aligned in the mapping
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::int32_t width;
+        std::int32_t height;
+        std::int32_t connectivity;
+        std::int32_t cornerCutting;
+        std::int32_t wordsPerRow;
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) % sizeof(BitGrid::Word) == 0, "The walls must start on a word boundary");
+
+    // Searches rely on the border and iteration on the row padding, so
+    // a file is only used if both are as a GridMap would leave them
+    bool hasValidEdges(const BitGrid& walls)
+    {
+        auto width = walls.getWidth();
+        auto height = walls.getHeight();
+        auto wordsPerRow = walls.getWordsPerRow();
+        auto words = walls.getWords();
+
+        auto paddingBits = width % BitGrid::BITS_PER_WORD;
+        auto paddingMask = (paddingBits == 0) ? BitGrid::Word(0) : ~((BitGrid::Word(1) << paddingBits) - 1);
+
+        for (int y = 0; y < height; ++y)
+        {
+            if (words[(y + 1) * wordsPerRow - 1] & paddingMask)
+                return false;
+
+            if (!walls.test(0, y) || !walls.test(width - 1, y))
+                return false;
+        }
+
+        for (int x = 0; x < width; ++x)
+        {
+            if (!walls.test(x, 0) || !walls.test(x, height - 1))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+MapFile::MapFile()
+    : m_Data(nullptr)
+    , m_Size(0)
+{
+
+}
+
+MapFile::~MapFile()
+{
+    close();
+}
+
+bool MapFile::save(const GridMap& map, const std::string& file)
+{
+    std::ofstream output(file, std::ios::binary);
+    if (!output)
+        return false;
+
+    auto& walls = map.getWalls();
+    Header header =
+    {
+        MAGIC, VERSION, map.getWidth(), map.getHeight(),
+        static_cast<std::int32_t>(map.getConnectivity()),
+        static_cast<std::int32_t>(map.getCornerCutting()),
+        walls.getWordsPerRow(), 0
+    };
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(walls.getWords()), walls.getNumWords() * sizeof(BitGrid::Word));
+
+    return static_cast<bool>(output);
+}
+
+bool MapFile::isMapFile(const std::string& file)
+{
+    std::ifstream input(file, std::ios::binary);
+
+    std::uint32_t magic = 0;
+    input.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+
+    return input && (magic == MAGIC);
+}
+
+bool MapFile::load(const std::string& file, GridMap& map)
+{
+    auto descriptor = ::open(file.c_str(), O_RDONLY);
+    if (descriptor == -1)
+        return false;
+
+    struct stat status;
+    if ((::fstat(descriptor, &status) == -1) || (status.st_size < static_cast<off_t>(sizeof(Header))))
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    // Private and writable, so edits stay in memory
+    auto size = static_cast<std::size_t>(status.st_size);
+    auto data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (data == MAP_FAILED)
+        return false;
+
+    auto& header = *static_cast<const Header*>(data);
+    auto words = reinterpret_cast<BitGrid::Word*>(static_cast<char*>(data) + sizeof(Header));
+
+    bool isValid = (header.magic == MAGIC) && (header.version == VERSION)
+        && (header.width >= 0) && (header.height >= 0)
+        && (header.wordsPerRow == (header.width + 2 + BitGrid::BITS_PER_WORD - 1) / BitGrid::BITS_PER_WORD)
+        && (header.connectivity >= 0) && (header.connectivity <= static_cast<std::int32_t>(Connectivity::Eight))
+        && (header.cornerCutting >= 0) && (header.cornerCutting <= static_cast<std::int32_t>(CornerCutting::Never))
+        && (size == sizeof(Header) + std::size_t(header.wordsPerRow) * (header.height + 2) * sizeof(BitGrid::Word));
+
+    if (isValid)
+    {
+        BitGrid walls;
+        walls.view(header.width + 2, header.height + 2, words);
+        isValid = hasValidEdges(walls);
+    }
+
+    // The map keeps whatever it had, which may be an earlier file
+    if (!isValid)
+    {
+        ::munmap(data, size);
+        return false;
+    }
+
+    map.view(header.width, header.height, words);
+    map.setConnectivity(static_cast<Connectivity>(header.connectivity));
+    map.setCornerCutting(static_cast<CornerCutting>(header.cornerCutting));
+
+    close();
+    m_Data = data;
+    m_Size = size;
+
+    return true;
+}
+
+void MapFile::close()
+{
+    if (m_Data)
+        ::munmap(m_Data, m_Size);
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
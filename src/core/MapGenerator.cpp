@@ -0,0 +1,122 @@
+#include "core/MapGenerator.hpp"
+
+#include "core/MazeMap.hpp"
+
+#include <vector>
+
+const int MapGenerator::MAX_DOOR_WIDTH = 3;
+
+MapGenerator::MapGenerator(std::uint32_t seed)
+    : m_Random(seed)
+{
+
+}
+
+int MapGenerator::getRandom(int bound)
+{
+    return static_cast<int>(m_Random() % static_cast<std::uint32_t>(bound));
+}
+
+Point MapGenerator::getRandomCell(const GridMap& map)
+{
+    while (true)
+    {
+        Point position = { getRandom(map.getWidth()), getRandom(map.getHeight()) };
+        if (!map.isWall(position))
+            return position;
+    }
+}
+
+void MapGenerator::generateRandom(GridMap& map, int size, int density)
+{
+    map.resize(size, size);
+
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            if (getRandom(100) < density)
+                map.addWall({ x, y });
+        }
+    }
+}
+
+void MapGenerator::generateMaze(GridMap& map, int size)
+{
+    const Direction SIDES[] = { Direction::North, Direction::East, Direction::South, Direction::West };
+
+    MazeMap maze((size - 1) / 2, (size - 1) / 2);
+
+    std::vector<char> isVisited(maze.getNumCells(), 0);
+    std::vector<int> stack(1, 0);
+    isVisited[0] = 1;
+
+    while (!stack.empty())
+    {
+        auto position = maze.getCellPosition(stack.back());
+
+        Direction unvisited[4];
+        int numUnvisited = 0;
+        for (auto side : SIDES)
+        {
+            auto delta = GridMap::getDelta(side);
+            Point neighbour = { position.x + delta.x, position.y + delta.y };
+
+            if (maze.isInside(neighbour) && !isVisited[maze.getCellIndex(neighbour)])
+                unvisited[numUnvisited++] = side;
+        }
+
+        if (numUnvisited == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        auto side = unvisited[getRandom(numUnvisited)];
+        auto delta = GridMap::getDelta(side);
+        Point next = { position.x + delta.x, position.y + delta.y };
+
+        maze.removeWall(position, side);
+        isVisited[maze.getCellIndex(next)] = 1;
+        stack.push_back(maze.getCellIndex(next));
+    }
+
+    maze.expand(map);
+}
+
+void MapGenerator::generateRooms(GridMap& map, int size, int roomSize)
+{
+    map.resize(size, size);
+
+    for (int line = roomSize - 1; line < size - 1; line += roomSize)
+    {
+        map.addWallRow(line, 0, size);
+        for (int y = 0; y < size; ++y)
+            map.addWall({ line, y });
+    }
+
+    for (int roomY = 0; roomY < size; roomY += roomSize)
+    {
+        for (int roomX = 0; roomX < size; roomX += roomSize)
+        {
+            auto wallX = roomX + roomSize - 1;
+            auto wallY = roomY + roomSize - 1;
+
+            if (wallX < size - 1)
+            {
+                auto width = 1 + getRandom(MAX_DOOR_WIDTH);
+                auto begin = roomY + getRandom(roomSize - width);
+                for (int y = begin; (y < begin + width) && (y < size); ++y)
+                    map.removeWall({ wallX, y });
+            }
+
+            if (wallY < size - 1)
+            {
+                auto width = 1 + getRandom(MAX_DOOR_WIDTH);
+                auto begin = roomX + getRandom(roomSize - width);
+                for (int x = begin; (x < begin + width) && (x < size); ++x)
+                    map.removeWall({ x, wallY });
+            }
+        }
+    }
+}
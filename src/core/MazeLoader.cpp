@@ -0,0 +1,127 @@
+#include "core/MazeLoader.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+    // Bits for the sides of a cell's NESW string
+    const std::uint8_t NORTH_SIDE = 1;
+    const std::uint8_t EAST_SIDE = 2;
+    const std::uint8_t SOUTH_SIDE = 4;
+    const std::uint8_t WEST_SIDE = 8;
+    const std::uint8_t ALL_SIDES = 0xF;
+
+    // Calls visit(x, y, node, length) for every cell string in the file,
+    // row by row, and returns the number of rows
+    template <typename Visitor>
+    int forEachNode(const std::string& text, Visitor visit)
+    {
+        int y = 0;
+        std::size_t lineStart = 0;
+        while (lineStart < text.size())
+        {
+            auto lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string::npos)
+                lineEnd = text.size();
+
+            int x = 0;
+            auto i = lineStart;
+            while (i < lineEnd)
+            {
+                if (std::isspace(static_cast<unsigned char>(text[i])))
+                {
+                    ++i;
+                    continue;
+                }
+
+                auto nodeStart = i;
+                while ((i < lineEnd) && !std::isspace(static_cast<unsigned char>(text[i])))
+                    ++i;
+
+                visit(x++, y, text.data() + nodeStart, i - nodeStart);
+            }
+
+            ++y;
+            lineStart = lineEnd + 1;
+        }
+
+        return y;
+    }
+}
+
+MazeLoader::MazeLoader(const std::string& file)
+    : m_File(file)
+{
+
+}
+
+bool MazeLoader::load(MazeMap& maze) const
+{
+    // Read once, then parsed in place without a string per cell
+    std::ifstream inputFile(m_File, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+
+    int width = 0;
+    forEachNode(text.substr(0, text.find('\n')), [&](int, int, const char*, std::size_t)
+    {
+        ++width;
+    });
+
+    if (width == 0)
+        return false;
+
+    // The sides each cell has a wall on, bit i for character i. A missing
+    // side or cell is a wall.
+    std::vector<std::uint8_t> sides;
+    auto height = forEachNode(text, [&](int x, int y, const char* node, std::size_t length)
+    {
+        if (x >= width)
+            return;
+
+        if (sides.size() < static_cast<std::size_t>((y + 1) * width))
+            sides.resize((y + 1) * width, ALL_SIDES);
+
+        std::uint8_t cellSides = 0;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            if ((i >= length) || (node[i] == '0'))
+                cellSides |= 1 << i;
+        }
+
+        sides[y * width + x] = cellSides;
+    });
+
+    sides.resize(height * width, ALL_SIDES);
+
+    // Every side starts as a wall, and is opened if neither cell sharing
+    // it has a wall there
+    maze.resize(width, height);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            auto cell = y * width + x;
+            if ((x + 1 < width) && !(sides[cell] & EAST_SIDE) && !(sides[cell + 1] & WEST_SIDE))
+                maze.removeWall({ x, y }, Direction::East);
+            if ((y + 1 < height) && !(sides[cell] & SOUTH_SIDE) && !(sides[cell + width] & NORTH_SIDE))
+                maze.removeWall({ x, y }, Direction::South);
+        }
+    }
+
+    return true;
+}
+
+bool MazeLoader::load(GridMap& map) const
+{
+    MazeMap maze;
+    if (!load(maze))
+        return false;
+
+    maze.expand(map);
+
+    return true;
+}
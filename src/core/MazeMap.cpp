@@ -0,0 +1,201 @@
+#include "core/MazeMap.hpp"
+
+#include <cassert>
+
+namespace
+{
+    const std::uint8_t ALL_SIDES = 0xF;
+
+    int getSideBit(Direction side)
+    {
+        assert(!GridMap::isDiagonal(side));
+        return static_cast<int>(side) / 2;
+    }
+
+    Direction getOppositeSide(Direction side)
+    {
+        return static_cast<Direction>((static_cast<int>(side) + 4) % 8);
+    }
+}
+
+MazeMap::MazeMap()
+    : m_Width(0)
+    , m_Height(0)
+{
+
+}
+
+MazeMap::MazeMap(int width, int height)
+    : m_Width(0)
+    , m_Height(0)
+{
+    resize(width, height);
+}
+
+void MazeMap::resize(int width, int height)
+{
+    m_Width = width;
+    m_Height = height;
+    m_Walls.assign((width * height + 1) / 2, ALL_SIDES | (ALL_SIDES << 4));
+}
+
+int MazeMap::getWidth() const
+{
+    return m_Width;
+}
+
+int MazeMap::getHeight() const
+{
+    return m_Height;
+}
+
+int MazeMap::getNumCells() const
+{
+    return m_Width * m_Height;
+}
+
+bool MazeMap::isInside(const Point& position) const
+{
+    return (position.x >= 0) && (position.x < m_Width) && (position.y >= 0) && (position.y < m_Height);
+}
+
+bool MazeMap::hasWall(int cell, Direction side) const
+{
+    return (getWalls(cell) >> getSideBit(side)) & 1;
+}
+
+bool MazeMap::hasWall(const Point& position, Direction side) const
+{
+    assert(isInside(position));
+
+    return hasWall(getCellIndex(position), side);
+}
+
+void MazeMap::addWall(const Point& position, Direction side)
+{
+    assert(isInside(position));
+
+    auto neighbor = GridMap::getDelta(side);
+    neighbor.x += position.x;
+    neighbor.y += position.y;
+
+    setWall(getCellIndex(position), side, true);
+    if (isInside(neighbor))
+        setWall(getCellIndex(neighbor), getOppositeSide(side), true);
+}
+
+void MazeMap::removeWall(const Point& position, Direction side)
+{
+    assert(isInside(position));
+
+    auto neighbor = GridMap::getDelta(side);
+    neighbor.x += position.x;
+    neighbor.y += position.y;
+
+    // The outer walls stay
+    if (!isInside(neighbor))
+        return;
+
+    setWall(getCellIndex(position), side, false);
+    setWall(getCellIndex(neighbor), getOppositeSide(side), false);
+}
+
+int MazeMap::getCellIndex(const Point& position) const
+{
+    return position.y * m_Width + position.x;
+}
+
+Point MazeMap::getCellPosition(int cell) const
+{
+    return { cell % m_Width, cell / m_Width };
+}
+
+int MazeMap::getOffset(Direction side) const
+{
+    auto delta = GridMap::getDelta(side);
+    return delta.y * m_Width + delta.x;
+}
+
+void MazeMap::expand(GridMap& map) const
+{
+    auto width = m_Width * 2 + 1;
+    auto height = m_Height * 2 + 1;
+    map.resize(width, height);
+
+    // The sides first: the outer walls, and the east and south side of
+    // each cell, which between them cover every side inside the maze
+    map.addWallRow(0, 0, width);
+    map.addWallRow(height - 1, 0, width);
+    for (int y = 1; y < height - 1; ++y)
+    {
+        map.addWall({ 0, y });
+        map.addWall({ width - 1, y });
+    }
+
+    for (int y = 0; y < m_Height; ++y)
+    {
+        for (int x = 0; x < m_Width; ++x)
+        {
+            auto cell = getCellIndex({ x, y });
+            if (hasWall(cell, Direction::East))
+                map.addWall({ x * 2 + 2, y * 2 + 1 });
+            if (hasWall(cell, Direction::South))
+                map.addWall({ x * 2 + 1, y * 2 + 2 });
+        }
+    }
+
+    // Then the posts between the sides. One left open next to a wall
+    // would let a search cut around the end of it.
+    for (int y = 2; y < height - 1; y += 2)
+    {
+        for (int x = 2; x < width - 1; x += 2)
+        {
+            if (map.isWall({ x, y - 1 }) || map.isWall({ x + 1, y })
+                || map.isWall({ x, y + 1 }) || map.isWall({ x - 1, y }))
+                map.addWall({ x, y });
+        }
+    }
+}
+
+Point MazeMap::toGridPosition(const Point& position)
+{
+    return { position.x * 2 + 1, position.y * 2 + 1 };
+}
+
+void MazeMap::toGridPath(const std::vector<Point>& path, std::vector<Point>& gridPath)
+{
+    gridPath.clear();
+    if (path.empty())
+        return;
+
+    // Each move between maze cells crosses the grid cell of their side
+    gridPath.push_back(toGridPosition(path.front()));
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+        auto position = toGridPosition(path[i]);
+        auto previous = gridPath.back();
+
+        gridPath.push_back({ (previous.x + position.x) / 2, (previous.y + position.y) / 2 });
+        gridPath.push_back(position);
+    }
+}
+
+std::size_t MazeMap::getMemoryUsage() const
+{
+    return m_Walls.size() * sizeof(std::uint8_t);
+}
+
+std::uint8_t MazeMap::getWalls(int cell) const
+{
+    return (m_Walls[cell / 2] >> ((cell % 2) * 4)) & ALL_SIDES;
+}
+
+void MazeMap::setWall(int cell, Direction side, bool isWall)
+{
+    auto bit = 1 << (getSideBit(side) + (cell % 2) * 4);
+
+    if (isWall)
+        m_Walls[cell / 2] |= bit;
+    else
+        m_Walls[cell / 2] &= ~bit;
+}
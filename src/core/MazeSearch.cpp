@@ -0,0 +1,100 @@
+#include "core/MazeSearch.hpp"
+
+#include "core/Heuristics.hpp"
+
+namespace
+{
+    // Two grid steps, one onto the side between the cells and one past it
+    const int MOVE_COST = 2 * GridCost::getStepCost(Direction::North);
+}
+
+MazeSearch::MazeSearch(const MazeMap& maze)
+    : m_Maze(maze)
+{
+
+}
+
+bool MazeSearch::findPath(const Point& start, const Point& goal)
+{
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    if (!m_Maze.isInside(start) || !m_Maze.isInside(goal))
+        return false;
+
+    prepare();
+
+    auto startCell = m_Maze.getCellIndex(start);
+    auto goalCell = m_Maze.getCellIndex(goal);
+
+    auto getHeuristic = [&](int cell)
+    {
+        return ManhattanHeuristic<GridCost>()(m_Maze.getCellPosition(cell), goal) * 2;
+    };
+
+    auto& startNode = m_Nodes.getNode(startCell);
+    startNode.parent = -1;
+    startNode.movementCost = 0;
+    m_Nodes.setState(startCell, CellState::Open);
+    m_OpenSet.push(startCell, { getHeuristic(startCell), 0 });
+
+    while (!m_OpenSet.isEmpty())
+    {
+        auto currentCell = m_OpenSet.pop();
+        auto& currentNode = m_Nodes.getNode(currentCell);
+        if (currentCell == goalCell)
+        {
+            m_PathCost = currentNode.movementCost;
+            m_Nodes.buildPath(m_Maze, goalCell, m_Path);
+
+            return true;
+        }
+
+        m_Nodes.setState(currentCell, CellState::Closed);
+        ++m_NumExpansions;
+
+        for (auto side : GridMap::CARDINAL_DIRECTIONS)
+        {
+            if (m_Maze.hasWall(currentCell, side))
+                continue;
+
+            auto neighborCell = currentCell + m_Maze.getOffset(side);
+            if (m_Nodes.isClosed(neighborCell))
+                continue;
+
+            auto tentativeMovementCost = currentNode.movementCost + MOVE_COST;
+
+            bool neighborInOpenSet = m_Nodes.isOpen(neighborCell);
+            auto& neighborNode = m_Nodes.getNode(neighborCell);
+            if (!neighborInOpenSet || (tentativeMovementCost < neighborNode.movementCost))
+            {
+                neighborNode.parent = currentCell;
+                neighborNode.movementCost = tentativeMovementCost;
+
+                SearchKey key = { tentativeMovementCost + getHeuristic(neighborCell), tentativeMovementCost };
+                if (neighborInOpenSet)
+                {
+                    m_OpenSet.decreaseKey(neighborCell, key);
+                }
+                else
+                {
+                    m_OpenSet.push(neighborCell, key);
+                    m_Nodes.setState(neighborCell, CellState::Open);
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void MazeSearch::prepare()
+{
+    auto numCells = m_Maze.getNumCells();
+    if (m_OpenSet.getCapacity() != numCells)
+        m_OpenSet.resize(numCells);
+
+    m_Nodes.prepare(numCells);
+    m_OpenSet.clear();
+}
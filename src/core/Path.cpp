@@ -0,0 +1,150 @@
+#include "core/Path.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+CompactPath::CompactPath()
+    : m_Start({ -1, -1 })
+    , m_NumSteps(0)
+{
+
+}
+
+void CompactPath::encode(const std::vector<Point>& path)
+{
+    m_Steps.clear();
+    m_NumSteps = 0;
+    m_Start = path.empty() ? Point{ -1, -1 } : path.front();
+
+    if (path.size() < 2)
+        return;
+
+    m_NumSteps = path.size() - 1;
+    m_Steps.assign((m_NumSteps + STEPS_PER_WORD - 1) / STEPS_PER_WORD, 0);
+
+    for (int i = 0; i < m_NumSteps; ++i)
+    {
+        auto direction = static_cast<std::uint64_t>(getDirection(path[i], path[i + 1]));
+        m_Steps[i / STEPS_PER_WORD] |= direction << ((i % STEPS_PER_WORD) * BITS_PER_STEP);
+    }
+}
+
+void CompactPath::decode(std::vector<Point>& path) const
+{
+    path.clear();
+    if (isEmpty())
+        return;
+
+    path.resize(m_NumSteps + 1);
+    path[0] = m_Start;
+
+    for (int i = 0; i < m_NumSteps; ++i)
+    {
+        auto delta = GridMap::getDelta(getStep(i));
+        path[i + 1] = { path[i].x + delta.x, path[i].y + delta.y };
+    }
+}
+
+bool CompactPath::isEmpty() const
+{
+    return m_Start == Point{ -1, -1 };
+}
+
+Point CompactPath::getStart() const
+{
+    return m_Start;
+}
+
+int CompactPath::getNumSteps() const
+{
+    return m_NumSteps;
+}
+
+Direction CompactPath::getStep(int index) const
+{
+    assert((index >= 0) && (index < m_NumSteps));
+
+    auto word = m_Steps[index / STEPS_PER_WORD];
+    return static_cast<Direction>((word >> ((index % STEPS_PER_WORD) * BITS_PER_STEP)) & 7);
+}
+
+int CompactPath::getSizeInBytes() const
+{
+    return m_Steps.size() * sizeof(std::uint64_t);
+}
+
+Direction CompactPath::getDirection(const Point& from, const Point& to)
+{
+    // Indexed by (deltaY + 1) * 3 + (deltaX + 1)
+    static const Direction directions[9] =
+    {
+        Direction::NorthWest, Direction::North, Direction::NorthEast,
+        Direction::West,      Direction::North, Direction::East,
+        Direction::SouthWest, Direction::South, Direction::SouthEast
+    };
+
+    auto deltaX = to.x - from.x;
+    auto deltaY = to.y - from.y;
+    assert((std::abs(deltaX) <= 1) && (std::abs(deltaY) <= 1) && ((deltaX != 0) || (deltaY != 0)));
+
+    return directions[(deltaY + 1) * 3 + (deltaX + 1)];
+}
+
+PathWriter::PathWriter(std::FILE* stream)
+    : m_Stream(stream)
+{
+
+}
+
+void PathWriter::write(const std::vector<Point>& path)
+{
+    // "->(" + two numbers of at most 11 characters + ", " + ")"
+    const int MAX_CHARS_PER_CELL = 30;
+    m_Buffer.resize(path.size() * MAX_CHARS_PER_CELL + 1);
+
+    auto cursor = m_Buffer.data();
+    for (unsigned i = 0; i < path.size(); ++i)
+    {
+        if (i > 0)
+            cursor = append(cursor, "->", 2);
+
+        cursor = append(cursor, "(", 1);
+        cursor = appendNumber(cursor, path[i].x);
+        cursor = append(cursor, ", ", 2);
+        cursor = appendNumber(cursor, path[i].y);
+        cursor = append(cursor, ")", 1);
+    }
+
+    cursor = append(cursor, "\n", 1);
+
+    std::fwrite(m_Buffer.data(), 1, cursor - m_Buffer.data(), m_Stream);
+}
+
+char* PathWriter::append(char* cursor, const char* text, int length)
+{
+    for (int i = 0; i < length; ++i)
+        *cursor++ = text[i];
+
+    return cursor;
+}
+
+char* PathWriter::appendNumber(char* cursor, int number)
+{
+    char digits[12];
+    int length = 0;
+
+    unsigned value = (number < 0) ? -static_cast<unsigned>(number) : number;
+    do
+    {
+        digits[length++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    if (number < 0)
+        digits[length++] = '-';
+
+    while (length > 0)
+        *cursor++ = digits[--length];
+
+    return cursor;
+}
@@ -0,0 +1,424 @@
+#include "core/PathDatabase.hpp"
+
+#include "core/BucketQueue.hpp"
+#include "core/Heuristics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+    const std::uint32_t MAGIC = 0x31445043; // "CPD1"
+    const std::uint32_t VERSION = 1;
+
+    const int DIRECTION_BITS = 3;
+    const std::uint32_t DIRECTION_MASK = (1u << DIRECTION_BITS) - 1;
+    const std::uint8_t ANY_MOVE = 0xFF;
+
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::int32_t width;
+        std::int32_t height;
+        std::int32_t connectivity;
+        std::int32_t cornerCutting;
+        std::uint32_t checksum;
+        std::uint32_t numCells;
+        std::uint64_t numRuns;
+    };
+
+    // The lowest numbered move in a set of them
+    int getFirstDirection(std::uint8_t moves)
+    {
+        int direction = 0;
+        while (!(moves & (1 << direction)))
+            ++direction;
+
+        return direction;
+    }
+
+    // Rows read from a file must be ones a lookup can trust: each starts
+    // with a run at the first target, targets rise strictly and stay in
+    // range, and every move is one the map allows
+    bool areRowsValid(const std::vector<std::uint64_t>& rowOffsets, const std::vector<std::uint32_t>& runs,
+                      std::size_t numCells, const GridMap& map)
+    {
+        unsigned legalDirections = 0;
+        for (int i = 0; i < map.getNumDirections(); ++i)
+            legalDirections |= 1u << static_cast<int>(map.getDirections()[i]);
+
+        if ((rowOffsets.front() != 0) || (rowOffsets.back() != runs.size()))
+            return false;
+
+        for (std::size_t source = 0; source < numCells; ++source)
+        {
+            auto begin = rowOffsets[source];
+            auto end = rowOffsets[source + 1];
+            if ((begin >= end) || (end > runs.size()) || ((runs[begin] >> DIRECTION_BITS) != 0))
+                return false;
+
+            for (auto i = begin; i < end; ++i)
+            {
+                auto target = runs[i] >> DIRECTION_BITS;
+                if ((target >= numCells) || ((i > begin) && (target <= (runs[i - 1] >> DIRECTION_BITS))))
+                    return false;
+
+                if (!(legalDirections & (1u << (runs[i] & DIRECTION_MASK))))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+PathDatabase::PathDatabase(const GridMap& map)
+    : m_Map(map)
+    , m_Revision(0)
+    , m_IsBuilt(false)
+{
+
+}
+
+void PathDatabase::build(int numThreads)
+{
+    if (numThreads <= 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    buildOrdering();
+
+    std::vector<std::vector<std::uint32_t>> rows(m_Cells.size());
+    buildRows(rows, numThreads);
+
+    m_RowOffsets.assign(1, 0);
+    m_Runs.clear();
+    for (auto& row : rows)
+    {
+        m_Runs.insert(m_Runs.end(), row.begin(), row.end());
+        m_RowOffsets.push_back(m_Runs.size());
+        std::vector<std::uint32_t>().swap(row);
+    }
+
+    m_Revision = m_Map.getRevision();
+    m_IsBuilt = true;
+}
+
+bool PathDatabase::save(const std::string& file) const
+{
+    if (!isCurrent())
+        return false;
+
+    std::ofstream output(file, std::ios::binary);
+    if (!output)
+        return false;
+
+    Header header =
+    {
+        MAGIC, VERSION, m_Map.getWidth(), m_Map.getHeight(),
+        static_cast<std::int32_t>(m_Map.getConnectivity()),
+        static_cast<std::int32_t>(m_Map.getCornerCutting()),
+        getMapChecksum(), static_cast<std::uint32_t>(m_Cells.size()), m_Runs.size()
+    };
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(m_RowOffsets.data()), m_RowOffsets.size() * sizeof(std::uint64_t));
+    output.write(reinterpret_cast<const char*>(m_Runs.data()), m_Runs.size() * sizeof(std::uint32_t));
+
+    return static_cast<bool>(output);
+}
+
+bool PathDatabase::load(const std::string& file)
+{
+    std::ifstream input(file, std::ios::binary);
+    if (!input)
+        return false;
+
+    Header header;
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if ((header.magic != MAGIC) || (header.version != VERSION)
+        || (header.width != m_Map.getWidth()) || (header.height != m_Map.getHeight())
+        || (header.connectivity != static_cast<std::int32_t>(m_Map.getConnectivity()))
+        || (header.cornerCutting != static_cast<std::int32_t>(m_Map.getCornerCutting()))
+        || (header.checksum != getMapChecksum()))
+        return false;
+
+    // The ordering is not stored: it follows from the map
+    buildOrdering();
+    if (header.numCells != m_Cells.size())
+        return false;
+
+    // The rest of the file must hold exactly the offsets and runs the
+    // header counts, so a bad count cannot size more than the file holds
+    auto dataBegin = input.tellg();
+    input.seekg(0, std::ios::end);
+    auto numBytes = static_cast<std::uint64_t>(input.tellg() - dataBegin);
+    input.seekg(dataBegin);
+
+    auto numOffsetBytes = (static_cast<std::uint64_t>(m_Cells.size()) + 1) * sizeof(std::uint64_t);
+    if ((numBytes < numOffsetBytes) || (header.numRuns != (numBytes - numOffsetBytes) / sizeof(std::uint32_t))
+        || ((numBytes - numOffsetBytes) % sizeof(std::uint32_t) != 0))
+        return false;
+
+    std::vector<std::uint64_t> rowOffsets(m_Cells.size() + 1);
+    std::vector<std::uint32_t> runs(header.numRuns);
+    input.read(reinterpret_cast<char*>(rowOffsets.data()), rowOffsets.size() * sizeof(std::uint64_t));
+    input.read(reinterpret_cast<char*>(runs.data()), runs.size() * sizeof(std::uint32_t));
+    if (!input || !areRowsValid(rowOffsets, runs, m_Cells.size(), m_Map))
+        return false;
+
+    m_RowOffsets.swap(rowOffsets);
+    m_Runs.swap(runs);
+    m_Revision = m_Map.getRevision();
+    m_IsBuilt = true;
+
+    return true;
+}
+
+bool PathDatabase::isCurrent() const
+{
+    return m_IsBuilt && (m_Revision == m_Map.getRevision());
+}
+
+bool PathDatabase::findPath(const Point& start, const Point& goal)
+{
+    m_Path.clear();
+    m_PathCost = 0;
+    m_NumExpansions = 0;
+
+    if (!isCurrent())
+        return false;
+
+    auto cell = m_Map.getCellIndex(start);
+    auto goalCell = m_Map.getCellIndex(goal);
+    if ((m_Orders[cell] == -1) || (m_Orders[goalCell] == -1) || (m_Regions[cell] != m_Regions[goalCell]))
+        return false;
+
+    // Loaded rows are checked, but a file can still hold legal moves that
+    // lead nowhere, so a walk off the map or longer than any path fails
+    m_Path.push_back(start);
+    while (cell != goalCell)
+    {
+        auto direction = getFirstMove(cell, goalCell);
+        if (!m_Map.canMove(cell, direction) || (m_NumExpansions >= static_cast<int>(m_Cells.size())))
+        {
+            m_Path.clear();
+            m_PathCost = 0;
+            return false;
+        }
+
+        cell += m_Map.getOffset(direction);
+        m_PathCost += GridCost::getStepCost(direction);
+        ++m_NumExpansions;
+
+        m_Path.push_back(m_Map.getCellPosition(cell));
+    }
+
+    return true;
+}
+
+std::size_t PathDatabase::getNumRuns() const
+{
+    return m_Runs.size();
+}
+
+std::size_t PathDatabase::getMemoryUsage() const
+{
+    return m_Runs.size() * sizeof(std::uint32_t) + m_RowOffsets.size() * sizeof(std::uint64_t)
+        + (m_Cells.size() + m_Orders.size() + m_Regions.size()) * sizeof(int);
+}
+
+void PathDatabase::buildOrdering()
+{
+    m_Cells.clear();
+    m_Orders.assign(m_Map.getNumCells(), -1);
+    m_Regions.assign(m_Map.getNumCells(), -1);
+
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    int numRegions = 0;
+    std::vector<int> stack;
+    for (int y = 0; y < m_Map.getHeight(); ++y)
+    {
+        for (int x = 0; x < m_Map.getWidth(); ++x)
+        {
+            auto root = m_Map.getCellIndex({ x, y });
+            if (m_Map.isWall(root) || (m_Orders[root] != -1))
+                continue;
+
+            stack.push_back(root);
+            while (!stack.empty())
+            {
+                auto cell = stack.back();
+                stack.pop_back();
+                if (m_Orders[cell] != -1)
+                    continue;
+
+                m_Orders[cell] = m_Cells.size();
+                m_Cells.push_back(cell);
+                m_Regions[cell] = numRegions;
+
+                // Pushed in reverse so the first direction is visited first
+                for (int i = numDirections - 1; i >= 0; --i)
+                {
+                    auto direction = directions[i];
+                    auto neighbor = cell + m_Map.getOffset(direction);
+                    if (m_Map.canMove(cell, direction) && (m_Orders[neighbor] == -1))
+                        stack.push_back(neighbor);
+                }
+            }
+
+            ++numRegions;
+        }
+    }
+}
+
+void PathDatabase::buildRows(std::vector<std::vector<std::uint32_t>>& rows, int numThreads)
+{
+    auto numCells = m_Map.getNumCells();
+    auto directions = m_Map.getDirections();
+    auto numDirections = m_Map.getNumDirections();
+
+    // Every search asks about the same moves, so they are looked up once
+    std::vector<std::uint8_t> legalMoves(numCells, 0);
+    for (auto cell : m_Cells)
+    {
+        for (int i = 0; i < numDirections; ++i)
+        {
+            if (m_Map.canMove(cell, directions[i]))
+                legalMoves[cell] |= 1 << i;
+        }
+    }
+
+    std::atomic<int> nextSource(0);
+
+    auto worker = [&]()
+    {
+
+        std::vector<int> distances(numCells);
+        std::vector<std::uint8_t> firstMoves(numCells);
+        BucketQueue openSet(numCells);
+
+        for (int source = nextSource++; source < static_cast<int>(m_Cells.size()); source = nextSource++)
+        {
+            auto sourceCell = m_Cells[source];
+            std::fill(distances.begin(), distances.end(), INT_MAX);
+            openSet.clear();
+
+            distances[sourceCell] = 0;
+            firstMoves[sourceCell] = ANY_MOVE;
+            openSet.push(sourceCell, { 0, 0 });
+
+            // Dijkstra, carrying along the set of optimal first moves: a
+            // cell reached at equal cost from several parents takes the
+            // moves of all of them
+            while (!openSet.isEmpty())
+            {
+                auto cell = openSet.pop();
+                auto distance = distances[cell];
+
+                for (int i = 0; i < numDirections; ++i)
+                {
+                    if (!(legalMoves[cell] & (1 << i)))
+                        continue;
+
+                    auto direction = directions[i];
+                    auto neighbor = cell + m_Map.getOffset(direction);
+                    auto neighborDistance = distance + GridCost::getStepCost(direction);
+                    auto moves = (cell == sourceCell)
+                        ? static_cast<std::uint8_t>(1 << static_cast<int>(direction))
+                        : firstMoves[cell];
+
+                    if (neighborDistance < distances[neighbor])
+                    {
+                        if (distances[neighbor] == INT_MAX)
+                            openSet.push(neighbor, { neighborDistance, neighborDistance });
+                        else
+                            openSet.decreaseKey(neighbor, { neighborDistance, neighborDistance });
+
+                        distances[neighbor] = neighborDistance;
+                        firstMoves[neighbor] = moves;
+                    }
+                    else if (neighborDistance == distances[neighbor])
+                    {
+                        firstMoves[neighbor] |= moves;
+                    }
+                }
+            }
+
+            // Cells in other regions are never asked for, and neither is
+            // the source itself, so they fit in any run
+            auto& row = rows[source];
+            std::uint8_t runMoves = 0;
+            for (int target = 0; target < static_cast<int>(m_Cells.size()); ++target)
+            {
+                auto targetCell = m_Cells[target];
+                auto moves = ((distances[targetCell] == INT_MAX) || (targetCell == sourceCell))
+                    ? ANY_MOVE
+                    : firstMoves[targetCell];
+
+                if (!row.empty() && (runMoves & moves))
+                {
+                    runMoves &= moves;
+                    continue;
+                }
+
+                // Settle the move of the finished run before starting another
+                if (!row.empty())
+                    row.back() |= getFirstDirection(runMoves);
+
+                row.push_back(static_cast<std::uint32_t>(target) << DIRECTION_BITS);
+                runMoves = moves;
+            }
+
+            if (!row.empty())
+                row.back() |= getFirstDirection(runMoves);
+
+            row.shrink_to_fit();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numThreads; ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+std::uint32_t PathDatabase::getMapChecksum() const
+{
+    // FNV-1a over the walls, row by row
+    std::uint32_t checksum = 2166136261u;
+    for (int y = 0; y < m_Map.getHeight(); ++y)
+    {
+        for (int x = 0; x < m_Map.getWidth(); ++x)
+        {
+            checksum ^= m_Map.isWall({ x, y }) ? 1u : 0u;
+            checksum *= 16777619u;
+        }
+    }
+
+    return checksum;
+}
+
+Direction PathDatabase::getFirstMove(int sourceCell, int targetCell) const
+{
+    auto source = m_Orders[sourceCell];
+    auto first = m_Runs.begin() + m_RowOffsets[source];
+    auto last = m_Runs.begin() + m_RowOffsets[source + 1];
+
+    // The last run starting at or before the target
+    auto key = (static_cast<std::uint32_t>(m_Orders[targetCell]) << DIRECTION_BITS) | DIRECTION_MASK;
+    auto run = std::upper_bound(first, last, key) - 1;
+
+    return static_cast<Direction>(*run & DIRECTION_MASK);
+}
@@ -0,0 +1,176 @@
+#include "core/PathfinderFactory.hpp"
+
+#include "core/AStarSearch.hpp"
+#include "core/BidirectionalSearch.hpp"
+#include "core/BucketQueue.hpp"
+#include "core/CorridorSearch.hpp"
+#include "core/DStarLite.hpp"
+#include "core/HierarchicalSearch.hpp"
+#include "core/JumpPointSearch.hpp"
+
+namespace
+{
+    struct AlgorithmName
+    {
+        const char* name;
+        SearchAlgorithm algorithm;
+    };
+
+    const AlgorithmName ALGORITHMS[] =
+    {
+        { "astar", SearchAlgorithm::AStar },
+        { "jps", SearchAlgorithm::JumpPoint },
+        { "jps+", SearchAlgorithm::JumpPointPlus },
+        { "bidirectional", SearchAlgorithm::Bidirectional },
+        { "dstar", SearchAlgorithm::Incremental },
+        { "hpa", SearchAlgorithm::Hierarchical },
+        { "corridors", SearchAlgorithm::Corridors }
+    };
+}
+
+template <typename Heuristic>
+std::unique_ptr<Pathfinder> PathfinderFactory::createAStarWith(const GridMap& map, double epsilon, OpenListType openList)
+{
+    typedef typename Heuristic::Cost Cost;
+
+    if (openList == OpenListType::Buckets)
+    {
+        auto search = new AStarSearch<Heuristic, Cost, BucketQueue>(map);
+        search->setSuboptimalityBound(epsilon);
+
+        return std::unique_ptr<Pathfinder>(search);
+    }
+
+    auto search = new AStarSearch<Heuristic, Cost>(map);
+    search->setSuboptimalityBound(epsilon);
+
+    return std::unique_ptr<Pathfinder>(search);
+}
+
+template <typename Cost>
+std::unique_ptr<Pathfinder> PathfinderFactory::createAStarFor(const GridMap& map, HeuristicType heuristic,
+                                                              double epsilon, OpenListType openList)
+{
+    switch (heuristic)
+    {
+        case HeuristicType::Manhattan:
+            return createAStarWith<ManhattanHeuristic<Cost>>(map, epsilon, openList);
+        case HeuristicType::Octile:
+            return createAStarWith<OctileHeuristic<Cost>>(map, epsilon, openList);
+        case HeuristicType::Euclidean:
+            return createAStarWith<EuclideanHeuristic<Cost>>(map, epsilon, openList);
+        case HeuristicType::Zero:
+            return createAStarWith<ZeroHeuristic<Cost>>(map, epsilon, openList);
+    }
+
+    return nullptr;
+}
+
+template <typename Cost>
+std::unique_ptr<Pathfinder> PathfinderFactory::createBidirectionalFor(const GridMap& map, HeuristicType heuristic)
+{
+    switch (heuristic)
+    {
+        case HeuristicType::Manhattan:
+            return std::unique_ptr<Pathfinder>(new BidirectionalSearch<ManhattanHeuristic<Cost>, Cost>(map));
+        case HeuristicType::Octile:
+            return std::unique_ptr<Pathfinder>(new BidirectionalSearch<OctileHeuristic<Cost>, Cost>(map));
+        case HeuristicType::Euclidean:
+            return std::unique_ptr<Pathfinder>(new BidirectionalSearch<EuclideanHeuristic<Cost>, Cost>(map));
+        case HeuristicType::Zero:
+            return std::unique_ptr<Pathfinder>(new BidirectionalSearch<ZeroHeuristic<Cost>, Cost>(map));
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<Pathfinder> PathfinderFactory::create(const GridMap& map, SearchAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+        case SearchAlgorithm::AStar:
+            return createAStar(map, getDefaultHeuristic(map));
+        case SearchAlgorithm::JumpPoint:
+            return createJumpPointSearch(map);
+        case SearchAlgorithm::JumpPointPlus:
+            return createJumpPointSearch(map, true);
+        case SearchAlgorithm::Bidirectional:
+            return createBidirectional(map, getDefaultHeuristic(map));
+        case SearchAlgorithm::Incremental:
+            return std::unique_ptr<Pathfinder>(new DStarLite(map));
+        case SearchAlgorithm::Hierarchical:
+            return std::unique_ptr<Pathfinder>(new HierarchicalSearch(map));
+        case SearchAlgorithm::Corridors:
+            return std::unique_ptr<Pathfinder>(new CorridorSearch(map));
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<Pathfinder> PathfinderFactory::createAStar(const GridMap& map, HeuristicType heuristic,
+                                                           double epsilon, OpenListType openList, StepCosts costs)
+{
+    if (costs == StepCosts::Fine)
+        return createAStarFor<FineGridCost>(map, heuristic, epsilon, openList);
+
+    return createAStarFor<GridCost>(map, heuristic, epsilon, openList);
+}
+
+std::unique_ptr<Pathfinder> PathfinderFactory::createLandmarkAStar(const GridMap& map, const LandmarkTable& landmarks)
+{
+    if (getDefaultHeuristic(map) == HeuristicType::Octile)
+    {
+        typedef LandmarkHeuristic<OctileHeuristic<GridCost>> Heuristic;
+        return std::unique_ptr<Pathfinder>(new AStarSearch<Heuristic>(map, Heuristic(landmarks)));
+    }
+
+    typedef LandmarkHeuristic<ManhattanHeuristic<GridCost>> Heuristic;
+    return std::unique_ptr<Pathfinder>(new AStarSearch<Heuristic>(map, Heuristic(landmarks)));
+}
+
+std::unique_ptr<Pathfinder> PathfinderFactory::createBidirectional(const GridMap& map, HeuristicType heuristic,
+                                                                   StepCosts costs)
+{
+    if (costs == StepCosts::Fine)
+        return createBidirectionalFor<FineGridCost>(map, heuristic);
+
+    return createBidirectionalFor<GridCost>(map, heuristic);
+}
+
+std::unique_ptr<Pathfinder> PathfinderFactory::createJumpPointSearch(const GridMap& map, bool usePrecomputedJumps)
+{
+    if (!JumpPointSearch::isSupported(map))
+        return createAStar(map, getDefaultHeuristic(map));
+
+    return std::unique_ptr<Pathfinder>(new JumpPointSearch(map, usePrecomputedJumps));
+}
+
+HeuristicType PathfinderFactory::getDefaultHeuristic(const GridMap& map)
+{
+    return (map.getConnectivity() == Connectivity::Eight) ? HeuristicType::Octile : HeuristicType::Manhattan;
+}
+
+bool PathfinderFactory::findAlgorithm(const std::string& name, SearchAlgorithm& algorithm)
+{
+    for (auto& entry : ALGORITHMS)
+    {
+        if (name == entry.name)
+        {
+            algorithm = entry.algorithm;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const char* PathfinderFactory::getAlgorithmName(SearchAlgorithm algorithm)
+{
+    for (auto& entry : ALGORITHMS)
+    {
+        if (entry.algorithm == algorithm)
+            return entry.name;
+    }
+
+    return "unknown";
+}
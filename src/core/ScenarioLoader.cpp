@@ -0,0 +1,47 @@
+#include "core/ScenarioLoader.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+ScenarioLoader::ScenarioLoader(const std::string& file)
+    : m_File(file)
+{
+
+}
+
+bool ScenarioLoader::load(std::vector<ScenarioQuery>& queries) const
+{
+    queries.clear();
+
+    std::ifstream inputFile(m_File);
+    if (!inputFile)
+    {
+        std::cerr << "Error opening " << m_File << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(inputFile, line))
+    {
+        std::stringstream strStream(line);
+
+        std::string first;
+        if (!(strStream >> first) || (first == "version"))
+            continue;
+
+        ScenarioQuery query;
+        std::stringstream(first) >> query.bucket;
+        if (!(strStream >> query.map >> query.mapWidth >> query.mapHeight
+                        >> query.start.x >> query.start.y >> query.goal.x >> query.goal.y
+                        >> query.optimalLength))
+        {
+            std::cerr << "Error parsing " << m_File << ", bad query: " << line << std::endl;
+            return false;
+        }
+
+        queries.push_back(query);
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+#include "core/SearchSpace.hpp"
+
+SearchNodes::SearchNodes()
+    : m_Generation(0)
+{
+
+}
+
+void SearchNodes::prepare(int numCells)
+{
+    if (static_cast<int>(m_Nodes.size()) != numCells)
+    {
+        m_Nodes.assign(numCells, { 0, -1, 0 });
+        m_Generation = 0;
+    }
+
+    // Each search uses two stamp values, one for open and one for closed.
+    // Only when the counter wraps around do the stamps have to be wiped.
+    m_Generation += 2;
+    if (m_Generation < 2)
+    {
+        for (auto& node : m_Nodes)
+            node.stamp = 0;
+
+        m_Generation = 2;
+    }
+}
+
+SearchSpace::SearchSpace(const GridMap& map)
+    : m_Map(map)
+{
+
+}
+
+void SearchSpace::prepare()
+{
+    m_Nodes.prepare(m_Map.getNumCells());
+}
+
+SearchNode& SearchSpace::getNode(int cell)
+{
+    return m_Nodes.getNode(cell);
+}
+
+const SearchNode& SearchSpace::getNode(int cell) const
+{
+    return m_Nodes.getNode(cell);
+}
+
+CellState SearchSpace::getState(int cell) const
+{
+    if (m_Nodes.isOpen(cell))
+        return CellState::Open;
+    if (m_Nodes.isClosed(cell))
+        return CellState::Closed;
+    if (m_Map.isWall(cell))
+        return CellState::Blocked;
+
+    return CellState::Unvisited;
+}
+
+void SearchSpace::setState(int cell, CellState state)
+{
+    m_Nodes.setState(cell, state);
+}
+
+void SearchSpace::buildPath(int cell, std::vector<Point>& path) const
+{
+    m_Nodes.buildPath(m_Map, cell, path);
+}
@@ -1,6 +1,7 @@
 #include "Application.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 int main(int argc, char** argv)
 {
@@ -10,8 +11,17 @@ int main(int argc, char** argv)
         auto height = std::atoi(argv[2]);
         auto file = std::string(argv[3]);
 
-        Application application(width, height, file);
-        application.run();
+        // A bad file is reported here rather than opening an empty window
+        try
+        {
+            Application application(width, height, file);
+            application.run();
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
     }
     else
     {
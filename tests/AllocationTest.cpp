@@ -0,0 +1,176 @@
+#include "core/DeadEndPruning.hpp"
+#include "core/MazeSearch.hpp"
+#include "core/PathfinderFactory.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int MAP_SIZE = 128;
+    const int NUM_QUERIES = 50;
+    const int WALL_PERCENT = 20;
+
+    struct Engine
+    {
+        SearchAlgorithm algorithm;
+        const char* name;
+    };
+
+    const Engine ENGINES[] =
+    {
+        { SearchAlgorithm::AStar, "astar" },
+        { SearchAlgorithm::JumpPoint, "jps" },
+        { SearchAlgorithm::JumpPointPlus, "jps+" },
+        { SearchAlgorithm::Bidirectional, "bidirectional" },
+        { SearchAlgorithm::Incremental, "dstar" },
+        { SearchAlgorithm::Hierarchical, "hpa" },
+        { SearchAlgorithm::Corridors, "corridors" }
+    };
+
+    bool g_IsCounting = false;
+    long g_NumAllocations = 0;
+
+    struct Query
+    {
+        Point start;
+        Point goal;
+    };
+
+    int getRandom(std::mt19937& random, int bound)
+    {
+        return static_cast<int>(random() % static_cast<std::uint32_t>(bound));
+    }
+
+    // The first run sizes every buffer for the queries, so the second,
+    // which asks for exactly the same paths, has nothing left to allocate
+    long countAllocations(Pathfinder& search, const std::vector<Query>& queries)
+    {
+        for (auto& query : queries)
+            search.findPath(query.start, query.goal);
+
+        g_NumAllocations = 0;
+        g_IsCounting = true;
+
+        for (auto& query : queries)
+            search.findPath(query.start, query.goal);
+
+        g_IsCounting = false;
+        return g_NumAllocations;
+    }
+
+    bool check(const std::string& name, Pathfinder& search, const std::vector<Query>& queries)
+    {
+        auto numAllocations = countAllocations(search, queries);
+        if (numAllocations == 0)
+            return true;
+
+        std::printf("FAILED: %s allocated %li times over %i repeated queries\n", name.c_str(), numAllocations,
+                    static_cast<int>(queries.size()));
+        return false;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (g_IsCounting)
+        ++g_NumAllocations;
+
+    auto memory = std::malloc((size == 0) ? 1 : size);
+    if (!memory)
+        throw std::bad_alloc();
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+// Checks that searching allocates nothing once its buffers are sized: each
+// engine runs a set of seeded queries once, then again while operator new
+// counts calls, and every count must be zero. Exits with 1 otherwise.
+int main()
+{
+    bool hasPassed = true;
+    for (auto connectivity : { Connectivity::Four, Connectivity::Eight })
+    {
+        auto suffix = (connectivity == Connectivity::Eight) ? std::string(", 8 directions") : std::string(", 4 directions");
+
+        std::mt19937 random(7);
+
+        GridMap map(MAP_SIZE, MAP_SIZE);
+        map.setConnectivity(connectivity);
+        map.setCornerCutting(CornerCutting::Never);
+        for (int y = 0; y < MAP_SIZE; ++y)
+        {
+            for (int x = 0; x < MAP_SIZE; ++x)
+            {
+                if (getRandom(random, 100) < WALL_PERCENT)
+                    map.addWall({ x, y });
+            }
+        }
+
+        std::vector<Query> queries;
+        while (static_cast<int>(queries.size()) < NUM_QUERIES)
+        {
+            Point start = { getRandom(random, MAP_SIZE), getRandom(random, MAP_SIZE) };
+            Point goal = { getRandom(random, MAP_SIZE), getRandom(random, MAP_SIZE) };
+            if (!map.isWall(start) && !map.isWall(goal))
+                queries.push_back({ start, goal });
+        }
+
+        for (auto& engine : ENGINES)
+        {
+            auto search = PathfinderFactory::create(map, engine.algorithm);
+            hasPassed &= check(engine.name + suffix, *search, queries);
+
+            // Opening blocks edits the map, which the precomputed graphs of
+            // HPA* and the corridor search have to be rebuilt after
+            if ((engine.algorithm == SearchAlgorithm::Hierarchical) || (engine.algorithm == SearchAlgorithm::Corridors))
+                continue;
+
+            DeadEndPruning pruned(map, engine.algorithm);
+            hasPassed &= check(std::string("pruned ") + engine.name + suffix, pruned, queries);
+        }
+
+        auto buckets = PathfinderFactory::createAStar(map, PathfinderFactory::getDefaultHeuristic(map), 0.0,
+                                                      OpenListType::Buckets);
+        hasPassed &= check("astar with buckets" + suffix, *buckets, queries);
+    }
+
+    // A maze with about half its inner walls knocked down, so there are
+    // loops as well as dead ends
+    std::mt19937 random(11);
+
+    MazeMap maze(MAP_SIZE / 2, MAP_SIZE / 2);
+    for (int y = 0; y < maze.getHeight(); ++y)
+    {
+        for (int x = 0; x < maze.getWidth(); ++x)
+        {
+            if ((x + 1 < maze.getWidth()) && (getRandom(random, 2) == 0))
+                maze.removeWall({ x, y }, Direction::East);
+            if ((y + 1 < maze.getHeight()) && (getRandom(random, 2) == 0))
+                maze.removeWall({ x, y }, Direction::South);
+        }
+    }
+
+    std::vector<Query> queries;
+    for (int i = 0; i < NUM_QUERIES; ++i)
+    {
+        queries.push_back({ { getRandom(random, maze.getWidth()), getRandom(random, maze.getHeight()) },
+                            { getRandom(random, maze.getWidth()), getRandom(random, maze.getHeight()) } });
+    }
+
+    MazeSearch mazeSearch(maze);
+    hasPassed &= check("maze", mazeSearch, queries);
+
+    std::printf(hasPassed ? "All searches allocation free\n" : "Some searches allocated\n");
+    return hasPassed ? 0 : 1;
+}
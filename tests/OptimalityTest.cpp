@@ -0,0 +1,650 @@
+#include "core/BitboardSearch.hpp"
+#include "core/ConnectedComponents.hpp"
+#include "core/DeadEndPruning.hpp"
+#include "core/MapGenerator.hpp"
+#include "core/MazeSearch.hpp"
+#include "core/Path.hpp"
+#include "core/PathDatabase.hpp"
+#include "core/PathfinderFactory.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    const int MAP_SIZE = 64;
+    const int DATABASE_MAP_SIZE = 32;
+    const int NUM_QUERIES = 40;
+    const int NUM_REPLANS = 20;
+    const int NUM_EDITS = 100;
+    const char* DATABASE_FILE = "OptimalityTest.cpd";
+
+    enum class MapType
+    {
+        Random,
+        Maze,
+        Rooms
+    };
+
+    struct MapSpec
+    {
+        MapType type;
+        const char* name;
+        int density;
+    };
+
+    const MapSpec MAPS[] =
+    {
+        { MapType::Random, "random 10%", 10 },
+        { MapType::Random, "random 25%", 25 },
+        { MapType::Random, "random 35%", 35 },
+        { MapType::Maze, "maze", 0 },
+        { MapType::Rooms, "rooms", 0 }
+    };
+
+    struct MovementRule
+    {
+        Connectivity connectivity;
+        CornerCutting cornerCutting;
+        const char* name;
+    };
+
+    const MovementRule RULES[] =
+    {
+        { Connectivity::Four, CornerCutting::Never, ", 4 directions" },
+        { Connectivity::Eight, CornerCutting::Never, ", 8 directions, corners never" },
+        { Connectivity::Eight, CornerCutting::NoSqueeze, ", 8 directions, corners no squeeze" },
+        { Connectivity::Eight, CornerCutting::Allow, ", 8 directions, corners allow" }
+    };
+
+    struct Query
+    {
+        Point start;
+        Point goal;
+    };
+
+    // Plain Dijkstra with a std::priority_queue and nothing shared with
+    // the engines but GridMap::canMove, so a bug in their common code
+    // cannot hide in both sides of the comparison
+    template <typename Cost>
+    class Dijkstra
+    {
+    public:
+        explicit Dijkstra(const GridMap& map)
+            : m_Map(map)
+        {
+
+        }
+
+        // The cost of the shortest path, or -1 if there is none. A wall at
+        // either end means there is none.
+        int getCost(const Point& start, const Point& goal)
+        {
+            if (m_Map.isWall(start) || m_Map.isWall(goal))
+                return -1;
+
+            typedef std::pair<int, int> Entry;
+
+            std::vector<int> costs(m_Map.getNumCells(), std::numeric_limits<int>::max());
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+            auto startCell = m_Map.getCellIndex(start);
+            auto goalCell = m_Map.getCellIndex(goal);
+
+            costs[startCell] = 0;
+            open.push({ 0, startCell });
+
+            while (!open.empty())
+            {
+                auto entry = open.top();
+                open.pop();
+
+                auto cell = entry.second;
+                if (entry.first > costs[cell])
+                    continue;
+                if (cell == goalCell)
+                    return entry.first;
+
+                for (int i = 0; i < m_Map.getNumDirections(); ++i)
+                {
+                    auto direction = m_Map.getDirections()[i];
+                    if (!m_Map.canMove(cell, direction))
+                        continue;
+
+                    auto neighbour = cell + m_Map.getOffset(direction);
+                    auto cost = entry.first + Cost::getStepCost(direction);
+                    if (cost < costs[neighbour])
+                    {
+                        costs[neighbour] = cost;
+                        open.push({ cost, neighbour });
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+    private:
+        const GridMap& m_Map;
+    };
+
+    // A path must run from the start to the goal in legal steps whose
+    // costs add up to the cost the engine reports
+    template <typename Cost>
+    bool isValidPath(const GridMap& map, const std::vector<Point>& path, const Query& query, int pathCost)
+    {
+        if (path.empty() || (path.front() != query.start) || (path.back() != query.goal))
+            return false;
+
+        int cost = 0;
+        for (std::size_t i = 1; i < path.size(); ++i)
+        {
+            bool isStep = false;
+            for (int j = 0; j < map.getNumDirections(); ++j)
+            {
+                auto direction = map.getDirections()[j];
+                if (map.getAdjacentNode(path[i - 1], direction) == path[i])
+                {
+                    if (!map.canMove(map.getCellIndex(path[i - 1]), direction))
+                        return false;
+
+                    cost += Cost::getStepCost(direction);
+                    isStep = true;
+                    break;
+                }
+            }
+
+            if (!isStep)
+                return false;
+        }
+
+        return cost == pathCost;
+    }
+
+    // Every path an engine returns must come back from a CompactPath
+    // unchanged, so the packed form can stand in for it
+    bool isRoundTrip(const std::vector<Point>& path)
+    {
+        CompactPath compact;
+        compact.encode(path);
+
+        std::vector<Point> decoded;
+        compact.decode(decoded);
+
+        return (decoded == path) && (compact.getNumSteps() == static_cast<int>(path.size()) - 1);
+    }
+
+    template <typename Cost>
+    bool check(const std::string& name, Pathfinder& search, const GridMap& map, const std::vector<Query>& queries)
+    {
+        Dijkstra<Cost> reference(map);
+
+        int numFailed = 0;
+        for (auto& query : queries)
+        {
+            auto expectedCost = reference.getCost(query.start, query.goal);
+            bool hasFoundPath = search.findPath(query.start, query.goal);
+
+            bool isCorrect = (expectedCost < 0)
+                ? !hasFoundPath
+                : (hasFoundPath && (search.getPathCost() == expectedCost)
+                   && isValidPath<Cost>(map, search.getPath(), query, search.getPathCost())
+                   && isRoundTrip(search.getPath()));
+
+            if (!isCorrect && (numFailed++ == 0))
+            {
+                std::printf("FAILED: %s, (%i, %i) to (%i, %i) expected cost %i, got %i\n", name.c_str(),
+                            query.start.x, query.start.y, query.goal.x, query.goal.y, expectedCost,
+                            hasFoundPath ? search.getPathCost() : -1);
+            }
+        }
+
+        if (numFailed > 1)
+            std::printf("FAILED: %s, %i of %i queries in all\n", name.c_str(), numFailed,
+                        static_cast<int>(queries.size()));
+
+        return numFailed == 0;
+    }
+
+    void generateMap(GridMap& map, const MapSpec& spec, int size, MapGenerator& generator)
+    {
+        switch (spec.type)
+        {
+            case MapType::Random:
+                generator.generateRandom(map, size, spec.density);
+                break;
+            case MapType::Maze:
+                generator.generateMaze(map, size);
+                break;
+            case MapType::Rooms:
+                generator.generateRooms(map, size, 8);
+                break;
+        }
+    }
+
+    // The maps all have walls, so this ends
+    Point getRandomWall(const GridMap& map, MapGenerator& generator)
+    {
+        while (true)
+        {
+            Point position = { generator.getRandom(map.getWidth()), generator.getRandom(map.getHeight()) };
+            if (map.isWall(position))
+                return position;
+        }
+    }
+
+    // Free cells picked at random, so some pairs lie in different regions
+    // and the engines have to agree there is no path. A few queries start
+    // or end on a wall, which every engine must treat as no path.
+    void generateQueries(const GridMap& map, MapGenerator& generator, std::vector<Query>& queries)
+    {
+        queries.clear();
+        for (int i = 0; i < NUM_QUERIES; ++i)
+            queries.push_back({ generator.getRandomCell(map), generator.getRandomCell(map) });
+
+        for (int i = 0; i < 2; ++i)
+        {
+            queries.push_back({ getRandomWall(map, generator), generator.getRandomCell(map) });
+            queries.push_back({ generator.getRandomCell(map), getRandomWall(map, generator) });
+        }
+    }
+
+    bool checkEngines(const std::string& mapName, const GridMap& map, const std::vector<Query>& queries)
+    {
+        const char* ALGORITHMS[] = { "astar", "jps", "jps+", "bidirectional", "dstar", "corridors" };
+
+        bool hasPassed = true;
+        for (auto name : ALGORITHMS)
+        {
+            SearchAlgorithm algorithm;
+            PathfinderFactory::findAlgorithm(name, algorithm);
+
+            auto search = PathfinderFactory::create(map, algorithm);
+            hasPassed &= check<GridCost>(name + mapName, *search, map, queries);
+
+            // Opening blocks would make the corridor graph rebuild for
+            // every query, so the application never prunes for it either
+            if (algorithm == SearchAlgorithm::Corridors)
+                continue;
+
+            DeadEndPruning pruned(map, algorithm);
+            hasPassed &= check<GridCost>(std::string("pruned ") + name + mapName, pruned, map, queries);
+        }
+
+        auto heuristic = PathfinderFactory::getDefaultHeuristic(map);
+
+        auto buckets = PathfinderFactory::createAStar(map, heuristic, 0.0, OpenListType::Buckets);
+        hasPassed &= check<GridCost>("astar with buckets" + mapName, *buckets, map, queries);
+
+        auto fine = PathfinderFactory::createAStar(map, heuristic, 0.0, OpenListType::BinaryHeap, StepCosts::Fine);
+        hasPassed &= check<FineGridCost>("astar with fine costs" + mapName, *fine, map, queries);
+
+        auto fineBidirectional = PathfinderFactory::createBidirectional(map, heuristic, StepCosts::Fine);
+        hasPassed &= check<FineGridCost>("bidirectional with fine costs" + mapName, *fineBidirectional, map,
+                                         queries);
+
+        LandmarkTable landmarks(map);
+        landmarks.build();
+        auto landmarkSearch = PathfinderFactory::createLandmarkAStar(map, landmarks);
+        hasPassed &= check<GridCost>("landmark astar" + mapName, *landmarkSearch, map, queries);
+
+        // HPA* paths need not be shortest, but they must still be legal
+        // and survive the round trip
+        auto hierarchical = PathfinderFactory::create(map, SearchAlgorithm::Hierarchical);
+        for (auto& query : queries)
+        {
+            if (hierarchical->findPath(query.start, query.goal)
+                && (!isValidPath<GridCost>(map, hierarchical->getPath(), query, hierarchical->getPathCost())
+                    || !isRoundTrip(hierarchical->getPath())))
+            {
+                std::printf("FAILED: hpa%s, (%i, %i) to (%i, %i) gave a bad path\n", mapName.c_str(),
+                            query.start.x, query.start.y, query.goal.x, query.goal.y);
+                hasPassed = false;
+                break;
+            }
+        }
+
+        return hasPassed;
+    }
+
+    // D* Lite keeps its costs between queries to the same goal, so walls
+    // are toggled between them and every repaired path is checked
+    bool checkReplanning(const std::string& mapName, GridMap& map, MapGenerator& generator)
+    {
+        auto search = PathfinderFactory::create(map, SearchAlgorithm::Incremental);
+        auto goal = generator.getRandomCell(map);
+
+        bool hasPassed = true;
+        for (int i = 0; i < NUM_REPLANS; ++i)
+        {
+            std::vector<Query> queries(1, { generator.getRandomCell(map), goal });
+            hasPassed &= check<GridCost>("dstar replanning" + mapName, *search, map, queries);
+
+            for (int j = 0; j < 8; ++j)
+            {
+                Point cell = { generator.getRandom(map.getWidth()), generator.getRandom(map.getHeight()) };
+                if (cell == goal)
+                    continue;
+
+                if (map.isWall(cell))
+                    map.removeWall(cell);
+                else
+                    map.addWall(cell);
+            }
+
+            // A wall at either end means no path. A wall as a new goal
+            // starts the search over, and must not seed costs that lead
+            // into it.
+            if ((i % 4) == 0)
+            {
+                auto wall = generator.getRandomCell(map);
+                map.addWall(wall);
+
+                std::vector<Query> wallQueries = { { queries.front().start, wall }, { wall, goal } };
+                hasPassed &= check<GridCost>("dstar replanning with a wall end" + mapName, *search, map,
+                                             wallQueries);
+
+                map.removeWall(wall);
+            }
+
+            if (map.isWall(goal))
+                map.removeWall(goal);
+        }
+
+        return hasPassed;
+    }
+
+    // The components are patched in place as walls come and go, so after
+    // every edit they must still agree with Dijkstra on what connects.
+    // One end of each query is the edited cell, where patches go wrong.
+    bool checkComponents(const std::string& mapName, GridMap& map, MapGenerator& generator)
+    {
+        ConnectedComponents components(map);
+        Dijkstra<GridCost> reference(map);
+
+        for (int i = 0; i < NUM_EDITS; ++i)
+        {
+            Point cell = { generator.getRandom(map.getWidth()), generator.getRandom(map.getHeight()) };
+            if (map.isWall(cell))
+                map.removeWall(cell);
+            else
+                map.addWall(cell);
+
+            const Query queries[] =
+            {
+                { generator.getRandomCell(map), cell },
+                { generator.getRandomCell(map), generator.getRandomCell(map) }
+            };
+
+            for (auto& query : queries)
+            {
+                bool isConnected = reference.getCost(query.start, query.goal) >= 0;
+                if (components.mayBeConnected(query.start, query.goal) != isConnected)
+                {
+                    std::printf("FAILED: components%s, after %i edits, (%i, %i) to (%i, %i) %s\n", mapName.c_str(),
+                                i + 1, query.start.x, query.start.y, query.goal.x, query.goal.y,
+                                isConnected ? "are connected" : "are not connected");
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // A wall added without splitting its region keeps the region's label.
+    // Here 1 and 2 are walled off from the region of 0, and 2 is then
+    // opened next to 4 alone, which must not join 0 and 4.
+    bool checkComponentsLabelledWall()
+    {
+        GridMap map(5, 1);
+        map.setConnectivity(Connectivity::Four);
+        map.addWall({ 3, 0 });
+
+        ConnectedComponents components(map);
+        components.update();
+
+        map.addWall({ 2, 0 });
+        map.addWall({ 1, 0 });
+        map.removeWall({ 3, 0 });
+        map.removeWall({ 2, 0 });
+
+        if (components.mayBeConnected({ 0, 0 }, { 4, 0 }) || !components.mayBeConnected({ 2, 0 }, { 4, 0 }))
+        {
+            std::printf("FAILED: components, a reopened wall kept its old region\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    std::string readFile(const std::string& file)
+    {
+        std::ifstream input(file, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::string& file, const std::string& contents)
+    {
+        std::ofstream(file, std::ios::binary).write(contents.data(), contents.size());
+    }
+
+    // The database's first moves must give Dijkstra's costs. Saved and
+    // loaded again it must give the same paths, and a file that was cut
+    // short, grown or has a run out of range must not load.
+    bool checkPathDatabase(const std::string& mapName, const GridMap& map, const std::vector<Query>& queries)
+    {
+        PathDatabase database(map);
+        database.build();
+        bool hasPassed = check<GridCost>("path database" + mapName, database, map, queries);
+
+        PathDatabase loaded(map);
+        if (!database.save(DATABASE_FILE) || !loaded.load(DATABASE_FILE))
+        {
+            std::printf("FAILED: path database%s did not save and load\n", mapName.c_str());
+            return false;
+        }
+
+        for (auto& query : queries)
+        {
+            bool hasFoundPath = database.findPath(query.start, query.goal);
+            if ((loaded.findPath(query.start, query.goal) != hasFoundPath)
+                || (loaded.getPath() != database.getPath()) || (loaded.getPathCost() != database.getPathCost()))
+            {
+                std::printf("FAILED: loaded path database%s, (%i, %i) to (%i, %i) differs\n", mapName.c_str(),
+                            query.start.x, query.start.y, query.goal.x, query.goal.y);
+                hasPassed = false;
+                break;
+            }
+        }
+
+        auto contents = readFile(DATABASE_FILE);
+
+        std::string badRun = contents;
+        badRun.replace(badRun.size() - 4, 4, 4, '\xff');
+
+        for (auto& corrupt : { contents.substr(0, contents.size() - 4), contents + std::string(4, '\0'), badRun })
+        {
+            writeFile(DATABASE_FILE, corrupt);
+            if (PathDatabase(map).load(DATABASE_FILE))
+            {
+                std::printf("FAILED: path database%s loaded a corrupt file\n", mapName.c_str());
+                hasPassed = false;
+            }
+        }
+
+        std::remove(DATABASE_FILE);
+        return hasPassed;
+    }
+
+    // BitboardSearch counts 4-connected steps, so its distances are held
+    // to Dijkstra's in GridCost straight steps. Rows are padded to whole
+    // words, so widths on either side of a word boundary are tried.
+    bool checkBitboard()
+    {
+        const Point SIZES[] = { { 1, 40 }, { 37, 20 }, { 63, 30 }, { 64, 30 }, { 65, 30 }, { 127, 9 }, { 130, 25 },
+                                { 200, 40 } };
+
+        MapGenerator generator(53);
+
+        bool hasPassed = true;
+        for (auto size : SIZES)
+        {
+            GridMap map(size.x, size.y);
+            for (int y = 0; y < size.y; ++y)
+            {
+                for (int x = 0; x < size.x; ++x)
+                {
+                    if (generator.getRandom(100) < 25)
+                        map.addWall({ x, y });
+                }
+            }
+
+            std::vector<Query> queries;
+            generateQueries(map, generator, queries);
+
+            Dijkstra<GridCost> reference(map);
+            BitboardSearch search(map);
+
+            for (auto& query : queries)
+            {
+                auto expectedCost = reference.getCost(query.start, query.goal);
+                auto expectedDistance = (expectedCost < 0) ? -1 : expectedCost / GridCost::STRAIGHT;
+
+                auto distance = search.getDistance(query.start, query.goal);
+                if ((distance != expectedDistance)
+                    || (search.isReachable(query.start, query.goal) != (expectedDistance != -1)))
+                {
+                    std::printf("FAILED: bitboard, %ix%i%s, (%i, %i) to (%i, %i) expected %i steps, got %i\n",
+                                size.x, size.y, search.usesAvx2() ? " with AVX2" : "", query.start.x,
+                                query.start.y, query.goal.x, query.goal.y, expectedDistance, distance);
+                    hasPassed = false;
+                    break;
+                }
+            }
+        }
+
+        return hasPassed;
+    }
+
+    // MazeSearch reports the cost of its path through the expanded grid,
+    // so it is held to Dijkstra on that grid
+    bool checkMaze()
+    {
+        MapGenerator generator(29);
+
+        MazeMap maze(MAP_SIZE / 2, MAP_SIZE / 2);
+        for (int y = 0; y < maze.getHeight(); ++y)
+        {
+            for (int x = 0; x < maze.getWidth(); ++x)
+            {
+                if ((x + 1 < maze.getWidth()) && (generator.getRandom(3) == 0))
+                    maze.removeWall({ x, y }, Direction::East);
+                if ((y + 1 < maze.getHeight()) && (generator.getRandom(3) == 0))
+                    maze.removeWall({ x, y }, Direction::South);
+            }
+        }
+
+        GridMap map;
+        maze.expand(map);
+        map.setConnectivity(Connectivity::Four);
+
+        Dijkstra<GridCost> reference(map);
+        MazeSearch search(maze);
+
+        std::vector<Point> gridPath;
+
+        int numFailed = 0;
+        for (int i = 0; i < NUM_QUERIES; ++i)
+        {
+            Point start = { generator.getRandom(maze.getWidth()), generator.getRandom(maze.getHeight()) };
+            Point goal = { generator.getRandom(maze.getWidth()), generator.getRandom(maze.getHeight()) };
+            Query query = { MazeMap::toGridPosition(start), MazeMap::toGridPosition(goal) };
+
+            auto expectedCost = reference.getCost(query.start, query.goal);
+            bool hasFoundPath = search.findPath(start, goal);
+
+            bool isCorrect = (expectedCost < 0) ? !hasFoundPath : hasFoundPath;
+            if (isCorrect && hasFoundPath)
+            {
+                MazeMap::toGridPath(search.getPath(), gridPath);
+                isCorrect = (search.getPathCost() == expectedCost)
+                    && isValidPath<GridCost>(map, gridPath, query, search.getPathCost())
+                    && isRoundTrip(search.getPath());
+            }
+
+            if (!isCorrect && (numFailed++ == 0))
+            {
+                std::printf("FAILED: maze, (%i, %i) to (%i, %i) expected cost %i, got %i\n", start.x, start.y,
+                            goal.x, goal.y, expectedCost, hasFoundPath ? search.getPathCost() : -1);
+            }
+        }
+
+        return numFailed == 0;
+    }
+}
+
+// Checks that every engine which claims optimal paths finds them: seeded
+// random, maze and rooms maps, in 4 directions and in 8 under each corner
+// cutting rule, are searched by each engine and by a plain Dijkstra, and
+// every path must be legal, cost what Dijkstra's does and come back from
+// a CompactPath unchanged. HPA* is only near-optimal, so its paths are
+// held to the last two alone. Exits with 1 on any mismatch.
+int main()
+{
+    bool hasPassed = true;
+    for (std::size_t i = 0; i < sizeof(MAPS) / sizeof(MAPS[0]); ++i)
+    {
+        MapGenerator generator(17 + static_cast<std::uint32_t>(i));
+
+        GridMap map;
+        generateMap(map, MAPS[i], MAP_SIZE, generator);
+
+        std::vector<Query> queries;
+        for (auto& rule : RULES)
+        {
+            map.setConnectivity(rule.connectivity);
+            map.setCornerCutting(rule.cornerCutting);
+            generateQueries(map, generator, queries);
+
+            auto mapName = std::string(", ") + MAPS[i].name + rule.name;
+            hasPassed &= checkEngines(mapName, map, queries);
+            hasPassed &= checkReplanning(mapName, map, generator);
+            hasPassed &= checkComponents(mapName, map, generator);
+        }
+    }
+
+    // A path database costs a Dijkstra per free cell to build, so it gets
+    // maps a quarter of the size
+    for (std::size_t i = 0; i < sizeof(MAPS) / sizeof(MAPS[0]); ++i)
+    {
+        MapGenerator generator(41 + static_cast<std::uint32_t>(i));
+
+        GridMap map;
+        generateMap(map, MAPS[i], DATABASE_MAP_SIZE, generator);
+
+        std::vector<Query> queries;
+        for (auto& rule : RULES)
+        {
+            map.setConnectivity(rule.connectivity);
+            map.setCornerCutting(rule.cornerCutting);
+            generateQueries(map, generator, queries);
+
+            hasPassed &= checkPathDatabase(std::string(", ") + MAPS[i].name + rule.name, map, queries);
+        }
+    }
+
+    hasPassed &= checkComponentsLabelledWall();
+    hasPassed &= checkMaze();
+    hasPassed &= checkBitboard();
+
+    std::printf(hasPassed ? "All searches optimal\n" : "Some searches were not optimal\n");
+    return hasPassed ? 0 : 1;
+}
@@ -0,0 +1,363 @@
+#include "core/ConnectedComponents.hpp"
+#include "core/MapGenerator.hpp"
+#include "core/PathfinderFactory.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::uint32_t SEED = 1024;
+    const int SIZES[] = { 64, 256, 1024, 4096 };
+    const int ROOM_SIZE = 16;
+
+    enum class MapType
+    {
+        Open,
+        Random,
+        Maze,
+        Rooms
+    };
+
+    struct MapSpec
+    {
+        MapType type;
+        const char* name;
+        int density;
+    };
+
+    const MapSpec MAPS[] =
+    {
+        { MapType::Open, "open", 0 },
+        { MapType::Random, "random", 10 },
+        { MapType::Random, "random", 20 },
+        { MapType::Random, "random", 30 },
+        { MapType::Maze, "maze", 0 },
+        { MapType::Rooms, "rooms", 0 }
+    };
+
+    struct OpenListName
+    {
+        const char* name;
+        OpenListType openList;
+    };
+
+    const OpenListName OPEN_LISTS[] =
+    {
+        { "heap", OpenListType::BinaryHeap },
+        { "buckets", OpenListType::Buckets }
+    };
+
+    struct Query
+    {
+        Point start;
+        Point goal;
+    };
+
+    struct Result
+    {
+        int numQueries;
+        int numSolved;
+        double setupMilliseconds;
+        double meanMicroseconds;
+        double p50Microseconds;
+        double p99Microseconds;
+        double maxMicroseconds;
+        double meanExpansions;
+        double expansionsPerSecond;
+        double meanCost;
+        long peakKilobytes;
+    };
+
+    void generateMap(GridMap& map, const MapSpec& spec, int size, MapGenerator& generator)
+    {
+        switch (spec.type)
+        {
+            case MapType::Open:
+                map.resize(size, size);
+                break;
+            case MapType::Random:
+                generator.generateRandom(map, size, spec.density);
+                break;
+            case MapType::Maze:
+                generator.generateMaze(map, size);
+                break;
+            case MapType::Rooms:
+                generator.generateRooms(map, size, ROOM_SIZE);
+                break;
+        }
+    }
+
+    // Pairs of distinct free cells with a path between them, so every
+    // query measures a search rather than a lookup of the regions
+    void generateQueries(const GridMap& map, int numQueries, MapGenerator& generator, std::vector<Query>& queries)
+    {
+        ConnectedComponents components(map);
+
+        queries.clear();
+        while (static_cast<int>(queries.size()) < numQueries)
+        {
+            auto start = generator.getRandomCell(map);
+            auto goal = generator.getRandomCell(map);
+
+            if ((start != goal) && components.mayBeConnected(start, goal))
+                queries.push_back({ start, goal });
+        }
+    }
+
+    // Linux keeps the peak resident size of the process, and can be
+    // asked to start it again from the current size. Elsewhere the peak
+    // is for the whole run.
+    void resetPeakMemory()
+    {
+        std::ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    long getPeakMemory()
+    {
+        std::ifstream status("/proc/self/status");
+
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+                return std::atol(line.c_str() + 6);
+        }
+
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    double getPercentile(const std::vector<double>& sorted, double percentile)
+    {
+        auto rank = static_cast<int>(std::ceil(percentile * sorted.size())) - 1;
+        return sorted[std::max(rank, 0)];
+    }
+
+    // The open list is an option of A* alone, the other engines always
+    // use their own
+    std::unique_ptr<Pathfinder> createSearch(const GridMap& map, SearchAlgorithm algorithm, OpenListType openList)
+    {
+        if (algorithm == SearchAlgorithm::AStar)
+            return PathfinderFactory::createAStar(map, PathfinderFactory::getDefaultHeuristic(map), 0.0, openList);
+
+        return PathfinderFactory::create(map, algorithm);
+    }
+
+    // The first query builds whatever the engine precomputes, so it is
+    // timed as setup and left out of the query stats
+    Result run(const GridMap& map, SearchAlgorithm algorithm, OpenListType openList, const std::vector<Query>& queries)
+    {
+        resetPeakMemory();
+
+        auto setupBegin = std::chrono::steady_clock::now();
+        auto search = createSearch(map, algorithm, openList);
+        search->findPath(queries.front().start, queries.front().goal);
+        auto setupEnd = std::chrono::steady_clock::now();
+
+        Result result = {};
+        result.numQueries = static_cast<int>(queries.size()) - 1;
+        result.setupMilliseconds = std::chrono::duration<double, std::milli>(setupEnd - setupBegin).count();
+
+        std::vector<double> latencies;
+        latencies.reserve(queries.size());
+
+        double totalMicroseconds = 0.0;
+        long long totalExpansions = 0;
+        long long totalCost = 0;
+        for (std::size_t i = 1; i < queries.size(); ++i)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            bool hasFoundPath = search->findPath(queries[i].start, queries[i].goal);
+            auto end = std::chrono::steady_clock::now();
+
+            auto microseconds = std::chrono::duration<double, std::micro>(end - begin).count();
+            latencies.push_back(microseconds);
+            totalMicroseconds += microseconds;
+            totalExpansions += search->getNumExpansions();
+
+            if (hasFoundPath)
+            {
+                ++result.numSolved;
+                totalCost += search->getPathCost();
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        result.meanMicroseconds = totalMicroseconds / result.numQueries;
+        result.p50Microseconds = getPercentile(latencies, 0.5);
+        result.p99Microseconds = getPercentile(latencies, 0.99);
+        result.maxMicroseconds = latencies.back();
+        result.meanExpansions = static_cast<double>(totalExpansions) / result.numQueries;
+        result.expansionsPerSecond = (totalMicroseconds > 0.0) ? totalExpansions / (totalMicroseconds / 1e6) : 0.0;
+        result.meanCost = (result.numSolved > 0) ? static_cast<double>(totalCost) / result.numSolved : 0.0;
+        result.peakKilobytes = getPeakMemory();
+
+        return result;
+    }
+
+    void printHeader(bool isJson)
+    {
+        if (isJson)
+        {
+            std::printf("[\n");
+            return;
+        }
+
+        std::printf("map,density,width,height,connectivity,algorithm,open_list,seed,queries,solved,setup_ms,"
+                    "mean_us,p50_us,p99_us,max_us,mean_expansions,expansions_per_sec,mean_cost,peak_kb\n");
+    }
+
+    void printResult(bool isJson, bool isFirst, const MapSpec& spec, const GridMap& map,
+                     SearchAlgorithm algorithm, const OpenListName& openList, std::uint32_t seed,
+                     const Result& result)
+    {
+        auto connectivity = (map.getConnectivity() == Connectivity::Eight) ? 8 : 4;
+        auto name = PathfinderFactory::getAlgorithmName(algorithm);
+
+        if (isJson)
+        {
+            std::printf("%s  {\"map\": \"%s\", \"density\": %i, \"width\": %i, \"height\": %i, "
+                        "\"connectivity\": %i, \"algorithm\": \"%s\", \"open_list\": \"%s\", "
+                        "\"seed\": %u, \"queries\": %i, "
+                        "\"solved\": %i, \"setup_ms\": %.3f, \"mean_us\": %.2f, \"p50_us\": %.2f, "
+                        "\"p99_us\": %.2f, \"max_us\": %.2f, \"mean_expansions\": %.1f, "
+                        "\"expansions_per_sec\": %.0f, \"mean_cost\": %.1f, \"peak_kb\": %li}",
+                        isFirst ? "" : ",\n", spec.name, spec.density, map.getWidth(), map.getHeight(),
+                        connectivity, name, openList.name, seed, result.numQueries, result.numSolved,
+                        result.setupMilliseconds,
+                        result.meanMicroseconds, result.p50Microseconds, result.p99Microseconds,
+                        result.maxMicroseconds, result.meanExpansions, result.expansionsPerSecond,
+                        result.meanCost, result.peakKilobytes);
+        }
+        else
+        {
+            std::printf("%s,%i,%i,%i,%i,%s,%s,%u,%i,%i,%.3f,%.2f,%.2f,%.2f,%.2f,%.1f,%.0f,%.1f,%li\n",
+                        spec.name, spec.density, map.getWidth(), map.getHeight(), connectivity, name,
+                        openList.name, seed,
+                        result.numQueries, result.numSolved, result.setupMilliseconds, result.meanMicroseconds,
+                        result.p50Microseconds, result.p99Microseconds, result.maxMicroseconds,
+                        result.meanExpansions, result.expansionsPerSecond, result.meanCost, result.peakKilobytes);
+        }
+
+        std::fflush(stdout);
+    }
+}
+
+// Times one search engine on seeded open, random, maze and rooms maps
+// from 64x64 up to the largest size asked for, in 4 and 8 directions.
+// Every map and query comes from a fixed seed, so two runs, or two
+// builds, measure the same work and their output can be diffed.
+int main(int argc, char** argv)
+{
+    if (argc > 6)
+    {
+        std::printf("Usage: ./bench [algorithm] [csv|json] [max size] [queries per map] [heap|buckets|both]\n");
+        std::printf("Algorithms: astar (default), jps, jps+, bidirectional, dstar, hpa, corridors\n");
+        return 1;
+    }
+
+    auto algorithm = SearchAlgorithm::AStar;
+    if ((argc > 1) && !PathfinderFactory::findAlgorithm(argv[1], algorithm))
+    {
+        std::printf("Unknown algorithm %s\n", argv[1]);
+        return 1;
+    }
+
+    std::string format = (argc > 2) ? argv[2] : "csv";
+    if ((format != "csv") && (format != "json"))
+    {
+        std::printf("Unknown format %s\n", format.c_str());
+        return 1;
+    }
+
+    bool isJson = (format == "json");
+    auto maxSize = (argc > 3) ? std::atoi(argv[3]) : 4096;
+    auto numQueries = (argc > 4) ? std::atoi(argv[4]) : 100;
+
+    if (numQueries < 1)
+    {
+        std::printf("Need at least one query per map\n");
+        return 1;
+    }
+
+    // Both runs every map with each open list, on the same queries
+    std::string openListName = (argc > 5) ? argv[5] : "heap";
+    std::vector<OpenListName> openLists;
+    for (auto& entry : OPEN_LISTS)
+    {
+        if ((openListName == entry.name) || (openListName == "both"))
+            openLists.push_back(entry);
+    }
+
+    if (openLists.empty())
+    {
+        std::printf("Unknown open list %s\n", openListName.c_str());
+        return 1;
+    }
+
+    if ((algorithm != SearchAlgorithm::AStar) && (openListName != "heap"))
+    {
+        std::printf("Only astar can use the bucket queue\n");
+        return 1;
+    }
+
+    printHeader(isJson);
+
+    bool isFirst = true;
+    for (std::size_t i = 0; i < sizeof(MAPS) / sizeof(MAPS[0]); ++i)
+    {
+        auto& spec = MAPS[i];
+
+        for (auto size : SIZES)
+        {
+            if (size > maxSize)
+                continue;
+
+            auto seed = SEED + static_cast<std::uint32_t>(i) * 65536 + static_cast<std::uint32_t>(size);
+            MapGenerator generator(seed);
+
+            GridMap map;
+            generateMap(map, spec, size, generator);
+
+            // A maze has no diagonal moves when corners cannot be cut,
+            // so 8 directions would only repeat the 4 direction run
+            for (auto connectivity : { Connectivity::Four, Connectivity::Eight })
+            {
+                if ((spec.type == MapType::Maze) && (connectivity == Connectivity::Eight))
+                    continue;
+
+                map.setConnectivity(connectivity);
+                map.setCornerCutting(CornerCutting::Never);
+
+                MapGenerator queryGenerator(seed + static_cast<std::uint32_t>(connectivity));
+                std::vector<Query> queries;
+                generateQueries(map, numQueries + 1, queryGenerator, queries);
+
+                for (auto& openList : openLists)
+                {
+                    auto result = run(map, algorithm, openList.openList, queries);
+                    printResult(isJson, isFirst, spec, map, algorithm, openList, seed, result);
+                    isFirst = false;
+                }
+            }
+        }
+    }
+
+    if (isJson)
+        std::printf("\n]\n");
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "core/BenchmarkMapLoader.hpp"
+#include "core/MapFile.hpp"
+#include "core/MazeLoader.hpp"
+
+#include <cstdio>
+#include <string>
+
+// Converts a text maze or a MovingAI .map into a binary map file, which
+// loads without any parsing
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::printf("Usage: ./MapConverter [maze or .map file] [map file]\n");
+        return 1;
+    }
+
+    GridMap map;
+    bool isLoaded = BenchmarkMapLoader::isBenchmarkMap(argv[1])
+        ? BenchmarkMapLoader(argv[1]).load(map)
+        : MazeLoader(argv[1]).load(map);
+
+    if (!isLoaded)
+    {
+        std::printf("Could not read %s\n", argv[1]);
+        return 1;
+    }
+
+    if (!MapFile::save(map, argv[2]))
+    {
+        std::printf("Could not write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("Wrote a %ix%i map to %s\n", map.getWidth(), map.getHeight(), argv[2]);
+
+    return 0;
+}
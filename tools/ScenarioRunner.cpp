@@ -0,0 +1,194 @@
+#include "core/BenchmarkMapLoader.hpp"
+#include "core/PathfinderFactory.hpp"
+#include "core/ScenarioLoader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace
+{
+    struct BucketStats
+    {
+        int numQueries;
+        int numOptimal;
+        int numCostOptimal;
+        double totalMicroseconds;
+        double maxMicroseconds;
+        long long totalExpansions;
+    };
+
+    // The length the benchmarks measure, with diagonal steps of sqrt(2)
+    // rather than the 1.4 GridCost rounds them to
+    double getLength(const std::vector<Point>& path)
+    {
+        double length = 0.0;
+        for (std::size_t i = 1; i < path.size(); ++i)
+        {
+            bool isDiagonal = (path[i].x != path[i - 1].x) && (path[i].y != path[i - 1].y);
+            length += isDiagonal ? std::sqrt(2.0) : 1.0;
+        }
+
+        return length;
+    }
+
+    // The scenario names its map relative to the benchmark set, so look
+    // next to the scenario for a file of that name
+    std::string findMap(const std::string& scenarioFile, const std::string& map)
+    {
+        auto slash = map.find_last_of('/');
+        auto name = (slash == std::string::npos) ? map : map.substr(slash + 1);
+
+        auto directoryEnd = scenarioFile.find_last_of('/');
+        if (directoryEnd == std::string::npos)
+            return name;
+
+        return scenarioFile.substr(0, directoryEnd + 1) + name;
+    }
+}
+
+// Runs every query of a MovingAI scenario and reports, per bucket, how
+// many paths had the expected optimal length and the time and expansions
+// they took. A path of the wrong length still passes if it is optimal for
+// the step costs the engine works in. Exits with 1 if any query fails.
+int main(int argc, char** argv)
+{
+    if ((argc < 2) || (argc > 5))
+    {
+        std::printf("Usage: ./ScenarioRunner [scenario file] [algorithm] [tolerance] [map file]\n");
+        std::printf("Algorithms: astar (default), jps, jps+, bidirectional, dstar, hpa, corridors\n");
+        return 1;
+    }
+
+    std::string scenarioFile = argv[1];
+
+    auto algorithm = SearchAlgorithm::AStar;
+    if (argc > 2)
+    {
+        if (!PathfinderFactory::findAlgorithm(argv[2], algorithm))
+        {
+            std::printf("Unknown algorithm %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    auto tolerance = (argc > 3) ? std::atof(argv[3]) : 1e-3;
+
+    std::vector<ScenarioQuery> queries;
+    if (!ScenarioLoader(scenarioFile).load(queries) || queries.empty())
+    {
+        std::printf("No queries in %s\n", scenarioFile.c_str());
+        return 1;
+    }
+
+    auto mapFile = (argc > 4) ? std::string(argv[4]) : findMap(scenarioFile, queries.front().map);
+
+    GridMap map;
+    if (!BenchmarkMapLoader(mapFile).load(map))
+    {
+        std::printf("Could not read %s\n", mapFile.c_str());
+        return 1;
+    }
+
+    if ((map.getWidth() != queries.front().mapWidth) || (map.getHeight() != queries.front().mapHeight))
+    {
+        std::printf("%s is %ix%i, the scenario expects %ix%i\n", mapFile.c_str(), map.getWidth(), map.getHeight(),
+                    queries.front().mapWidth, queries.front().mapHeight);
+        return 1;
+    }
+
+    // A* and bidirectional A* take the step costs as a policy, and with
+    // 1.414 diagonals find the paths the benchmarks call shortest. The
+    // other engines work in GridCost.
+    auto costs = StepCosts::Grid;
+    std::unique_ptr<Pathfinder> search;
+    if (algorithm == SearchAlgorithm::AStar)
+    {
+        costs = StepCosts::Fine;
+        search = PathfinderFactory::createAStar(map, PathfinderFactory::getDefaultHeuristic(map), 0.0,
+                                                OpenListType::BinaryHeap, costs);
+    }
+    else if (algorithm == SearchAlgorithm::Bidirectional)
+    {
+        costs = StepCosts::Fine;
+        search = PathfinderFactory::createBidirectional(map, PathfinderFactory::getDefaultHeuristic(map), costs);
+    }
+    else
+    {
+        search = PathfinderFactory::create(map, algorithm);
+    }
+
+    // Paths of the wrong length are costed again by plain A* in the same
+    // step costs. Matching it means the path is optimal in the engine's
+    // own metric, and only the rounded diagonal made it longer.
+    auto reference = PathfinderFactory::createAStar(map, PathfinderFactory::getDefaultHeuristic(map), 0.0,
+                                                    OpenListType::BinaryHeap, costs);
+
+    std::map<int, BucketStats> buckets;
+    for (auto& query : queries)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        bool hasFoundPath = search->findPath(query.start, query.goal);
+        auto end = std::chrono::steady_clock::now();
+
+        auto microseconds = std::chrono::duration<double, std::micro>(end - begin).count();
+
+        // Unreachable queries are listed with a length of 0
+        bool isOptimal = hasFoundPath
+            ? (std::fabs(getLength(search->getPath()) - query.optimalLength) <= tolerance)
+            : (query.optimalLength == 0.0);
+
+        bool isCostOptimal = false;
+        if (!isOptimal && hasFoundPath)
+        {
+            isCostOptimal = reference->findPath(query.start, query.goal)
+                && (search->getPathCost() == reference->getPathCost());
+        }
+
+        if (!isOptimal)
+        {
+            std::printf("Bucket %i: (%i, %i) to (%i, %i) expected %.5f, got %.5f%s\n", query.bucket,
+                        query.start.x, query.start.y, query.goal.x, query.goal.y, query.optimalLength,
+                        hasFoundPath ? getLength(search->getPath()) : -1.0,
+                        isCostOptimal ? ", optimal for its step costs" : "");
+        }
+
+        auto& stats = buckets[query.bucket];
+        ++stats.numQueries;
+        stats.numOptimal += isOptimal ? 1 : 0;
+        stats.numCostOptimal += isCostOptimal ? 1 : 0;
+        stats.totalMicroseconds += microseconds;
+        stats.maxMicroseconds = std::max(stats.maxMicroseconds, microseconds);
+        stats.totalExpansions += search->getNumExpansions();
+    }
+
+    BucketStats total = { 0, 0, 0, 0.0, 0.0, 0 };
+
+    std::printf("%-8s %8s %8s %8s %12s %12s %16s\n", "bucket", "queries", "optimal", "cost-opt", "mean us", "max us",
+                "mean expansions");
+    for (auto& entry : buckets)
+    {
+        auto& stats = entry.second;
+        std::printf("%-8i %8i %8i %8i %12.1f %12.1f %16.1f\n", entry.first, stats.numQueries, stats.numOptimal,
+                    stats.numCostOptimal, stats.totalMicroseconds / stats.numQueries, stats.maxMicroseconds,
+                    static_cast<double>(stats.totalExpansions) / stats.numQueries);
+
+        total.numQueries += stats.numQueries;
+        total.numOptimal += stats.numOptimal;
+        total.numCostOptimal += stats.numCostOptimal;
+        total.totalMicroseconds += stats.totalMicroseconds;
+        total.maxMicroseconds = std::max(total.maxMicroseconds, stats.maxMicroseconds);
+        total.totalExpansions += stats.totalExpansions;
+    }
+
+    std::printf("%-8s %8i %8i %8i %12.1f %12.1f %16.1f\n", "all", total.numQueries, total.numOptimal,
+                total.numCostOptimal, total.totalMicroseconds / total.numQueries, total.maxMicroseconds,
+                static_cast<double>(total.totalExpansions) / total.numQueries);
+
+    return (total.numOptimal + total.numCostOptimal == total.numQueries) ? 0 : 1;
+}